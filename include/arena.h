@@ -0,0 +1,85 @@
+#pragma once
+
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <string_view>
+
+
+namespace TDEngine2
+{
+	/*!
+		class MemoryArena
+
+		\brief The class is a bump allocator that places objects into large contiguous blocks. Objects can't be freed one by one,
+		all of them are destroyed at once via Reset or when the arena itself is destroyed. Destructors of non-trivially destructible
+		objects are called in reverse order of their creation
+	*/
+
+	class MemoryArena
+	{
+		public:
+			static constexpr size_t mDefaultBlockSize = 64 * 1024;
+		public:
+			explicit MemoryArena(size_t blockSize = mDefaultBlockSize);
+			~MemoryArena();
+
+			MemoryArena(const MemoryArena&) = delete;
+			MemoryArena& operator= (const MemoryArena&) = delete;
+
+			void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+			template <typename T, typename... TArgs>
+			T* Create(TArgs&&... args)
+			{
+				T* pObject = new (Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+
+				if constexpr (!std::is_trivially_destructible_v<T>)
+				{
+					mDestructors.push_back({ pObject, [](void* pPtr) { static_cast<T*>(pPtr)->~T(); } });
+				}
+
+				return pObject;
+			}
+
+			/*!
+				\brief The method copies the string into the arena, the returned view stays valid until Reset is called
+			*/
+
+			std::string_view CreateString(std::string_view str);
+
+			/*!
+				\brief The method destroys all created objects. The first block is kept to be reused, the rest ones are released
+			*/
+
+			void Reset();
+
+			size_t GetUsedSize() const;
+		private:
+			struct TDestructorEntry
+			{
+				void* mpObject;
+				void (*mpDestructor)(void*);
+			};
+
+			struct TBlock
+			{
+				std::unique_ptr<uint8_t[]> mpData;
+				size_t                     mSize;
+			};
+		private:
+			void _destroyObjects();
+		private:
+			std::vector<TBlock>           mBlocks;
+			std::vector<TDestructorEntry> mDestructors;
+
+			size_t                        mBlockSize;
+			size_t                        mCurrBlockOffset = 0;
+			size_t                        mUsedSize = 0; // \note Total size of all allocations including alignment paddings
+	};
+}
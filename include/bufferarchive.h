@@ -0,0 +1,149 @@
+#pragma once
+
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <limits>
+
+
+namespace TDEngine2
+{
+	/*!
+		class BufferWriterArchive
+
+		\brief The class serializes data into a growable in-memory buffer. Integers are written as LEB128 varints, signed ones
+		are zigzag-encoded before that, so small values take a single byte regardless of their type. Strings are written
+		as a varint length and raw bytes. The whole buffer is written into a file with a single call
+	*/
+
+	class BufferWriterArchive
+	{
+		public:
+			BufferWriterArchive() = default;
+			explicit BufferWriterArchive(size_t capacity);
+
+			template <typename T>
+			BufferWriterArchive& operator<< (T value)
+			{
+				static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Only integral types, enumerations and strings are supported");
+
+				if constexpr (std::is_enum_v<T>)
+				{
+					return *this << static_cast<std::underlying_type_t<T>>(value);
+				}
+				else if constexpr (std::is_same_v<T, bool>)
+				{
+					mBuffer.push_back(value ? 1 : 0);
+				}
+				else if constexpr (std::is_signed_v<T>)
+				{
+					const int64_t signedValue = static_cast<int64_t>(value);
+					WriteVarint((static_cast<uint64_t>(signedValue) << 1) ^ static_cast<uint64_t>(signedValue >> 63));
+				}
+				else
+				{
+					WriteVarint(static_cast<uint64_t>(value));
+				}
+
+				return *this;
+			}
+
+			BufferWriterArchive& operator<< (std::string_view value);
+			BufferWriterArchive& operator<< (const std::string& value);
+			BufferWriterArchive& operator<< (const char* pValue);
+
+			void WriteVarint(uint64_t value);
+			void WriteBytes(const void* pData, size_t size);
+
+			/*!
+				\brief The method writes the buffer into the file with a single call, the file's content is replaced
+			*/
+
+			bool SaveToFile(const std::string& filename) const;
+
+			void Reset();
+
+			const std::string& GetBuffer() const;
+		private:
+			std::string mBuffer;
+	};
+
+
+	/*!
+		class BufferReaderArchive
+
+		\brief The class deserializes data that's written with BufferWriterArchive from a memory span. The archive doesn't own
+		the data. Reads beyond the span or malformed varints put it into a failed state, after that all reads return zeros
+		and empty strings, so a caller could check HasFailed once after a batch of reads
+	*/
+
+	class BufferReaderArchive
+	{
+		public:
+			explicit BufferReaderArchive(std::string_view data);
+
+			template <typename T>
+			BufferReaderArchive& operator>> (T& value)
+			{
+				static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Only integral types, enumerations and strings are supported");
+
+				if constexpr (std::is_enum_v<T>)
+				{
+					std::underlying_type_t<T> underlyingValue {};
+					*this >> underlyingValue;
+
+					value = static_cast<T>(underlyingValue);
+				}
+				else if constexpr (std::is_same_v<T, bool>)
+				{
+					uint8_t byte = 0;
+					value = ReadBytes(&byte, sizeof(byte)) && byte;
+				}
+				else if constexpr (std::is_signed_v<T>)
+				{
+					uint64_t encodedValue = 0;
+					ReadVarint(encodedValue);
+
+					const int64_t signedValue = static_cast<int64_t>(encodedValue >> 1) ^ -static_cast<int64_t>(encodedValue & 1);
+					value = _checkRange<T>(signedValue) ? static_cast<T>(signedValue) : T {};
+				}
+				else
+				{
+					uint64_t unsignedValue = 0;
+					ReadVarint(unsignedValue);
+
+					value = _checkRange<T>(unsignedValue) ? static_cast<T>(unsignedValue) : T {};
+				}
+
+				return *this;
+			}
+
+			BufferReaderArchive& operator>> (std::string& value);
+
+			bool ReadVarint(uint64_t& value);
+			bool ReadBytes(void* pData, size_t size);
+
+			bool HasFailed() const;
+
+			size_t GetRemainingSize() const;
+		private:
+			template <typename T, typename U>
+			bool _checkRange(U value)
+			{
+				if (value < static_cast<U>((std::numeric_limits<T>::min)()) || value > static_cast<U>((std::numeric_limits<T>::max)()))
+				{
+					mHasFailed = true;
+					return false;
+				}
+
+				return true;
+			}
+		private:
+			std::string_view mData;
+			size_t           mPosition = 0;
+
+			bool             mHasFailed = false;
+	};
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include "hash.h"
+#include "lexer.h"
+
+
+namespace TDEngine2
+{
+	/*!
+		class CachePack
+
+		\brief The class is a single file that contains serialized symbol tables of all headers. Its layout is the following:
+
+		| Header | Offsets table (sorted by keys) | Blobs |
+
+		The pack is mapped into memory, so a worker gets its blob via a binary search over the table without any
+		file operations. New blobs and blobs that were requested during the run are written into a new pack that
+		replaces the old one at once, so an interrupted run never leaves a broken pack
+	*/
+
+	class CachePack
+	{
+		public:
+			CachePack() = default;
+			~CachePack();
+
+			CachePack(const CachePack&) = delete;
+			CachePack& operator= (const CachePack&) = delete;
+
+			/*!
+				\brief The method maps an existing pack. It returns false if there is no pack or it has unknown format,
+				in this case the pack is treated as an empty one
+			*/
+
+			bool Open(const std::string& filename);
+
+			/*!
+				\brief The method returns a blob that corresponds to the key or an empty view if there is no one. The found blob
+				is kept when the pack is saved. The method is thread-safe, the view stays valid until Save is called
+			*/
+
+			std::string_view Find(const THash128& key);
+
+			/*!
+				\brief The method adds a new blob into the pack, it's thread-safe
+			*/
+
+			void Add(const THash128& key, std::string&& blob);
+
+			/*!
+				\brief The method writes the pack if it has been changed. The data is written into a temporary file first, then
+				it's renamed over the old pack
+			*/
+
+			bool Save(const std::string& filename);
+		private:
+			static constexpr uint32_t mMagic = 0x4B504454; ///< TDPK
+			static constexpr uint32_t mFormatVersion = 2;
+			static constexpr uint64_t mBlobAlignment = 8;
+
+			struct THeader
+			{
+				uint32_t mMagic;
+				uint32_t mVersion;
+				uint64_t mEntriesCount;
+			};
+
+			struct TEntry
+			{
+				uint64_t mKeyLow;
+				uint64_t mKeyHigh;
+				uint64_t mOffset; ///< Offset of the blob from the beginning of the file
+				uint64_t mSize;
+			};
+
+			struct TNewBlob
+			{
+				THash128    mKey;
+				std::string mData;
+			};
+		private:
+			void _close();
+		private:
+			std::unique_ptr<MemoryMappedInputStream> mpMappedFile;
+
+			const TEntry*                            mpEntries = nullptr;
+			uint64_t                                 mEntriesCount = 0;
+
+			std::mutex                               mMutex;
+
+			std::vector<bool>                        mUsedEntries;
+			std::vector<TNewBlob>                    mNewBlobs;
+	};
+}
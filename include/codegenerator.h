@@ -2,7 +2,9 @@
 
 
 #include "symtable.h"
+#include "symtableview.h"
 #include "common.h"
+#include "codetemplate.h"
 #include "../deps/Wrench/source/stringUtils.hpp"
 #include <functional>
 #include <set>
@@ -19,13 +21,19 @@ namespace TDEngine2
 	{
 		public:
 			using TOutputStreamFactoryFunctor = std::function<std::unique_ptr<IOutputStream>(const std::string)>;
-			using TSymbolTablesArray = std::vector<std::unique_ptr<SymTable>>;
+			using TSymbolTablesArray = std::vector<TSymTableSource>;
 		public:
 			CodeGenerator();
 			~CodeGenerator();
 
 			bool Init(const TOutputStreamFactoryFunctor& outputStreamsFactory, const std::string& outputFilename, const E_EMIT_FLAGS& flags, 
-						const std::vector<std::regex>& excludeTypenamePatterns, bool isTaggedOnlyModeEnabled);
+						const std::vector<std::regex>& excludeTypenamePatterns, bool isTaggedOnlyModeEnabled, uint32_t threadsCount = 1);
+
+			/*!
+				\brief The method extracts types from all symbol tables and writes their meta-information. Extraction of
+				separate tables runs in parallel if more than one thread is allowed, the output doesn't depend on threads count.
+				Sources that contain only a view of a cached table get their own table that keeps extracted types
+			*/
 
 			bool Generate(TSymbolTablesArray&& symbolTablesPerFile);
 
@@ -36,26 +44,53 @@ namespace TDEngine2
 			void VisitNamespaceType(const TNamespaceType& type) override;
 			void VisitClassType(const TClassType& type) override;
 
+			/*!
+				\brief The method generates traits of given types in parallel. Each job writes a contiguous chunk of types into
+				its own buffer, then buffers are concatenated in order of chunks, so the output is the same for any threads count
+			*/
+
 			template <typename T>
-			bool WriteMetaData(const std::string& comment, const MetaExtractor<T>& metaExtractor)
+			bool WriteMetaData(const std::string& comment, const typename MetaExtractor<T>::TTypesArray& entities)
 			{
-				mpHeaderOutputStream->WriteString(comment);
+				const uint32_t chunksCount = static_cast<uint32_t>((std::min)(static_cast<size_t>(mThreadsCount * mChunksPerThread), entities.size()));
 
-				auto&& entities = metaExtractor.GetTypesInfo();
+				std::vector<std::string> chunks(chunksCount);
 
-				for (auto currMetaEntity : entities)
+				_executeJobs(chunksCount, [this, &entities, &chunks, chunksCount](uint32_t chunkIndex)
 				{
-					currMetaEntity->Visit(*this);
+					const size_t firstIndex = entities.size() * chunkIndex / chunksCount;
+					const size_t lastIndex = entities.size() * (chunkIndex + 1) / chunksCount;
+
+					std::string& output = chunks[chunkIndex];
+
+					for (size_t i = firstIndex; i < lastIndex; ++i)
+					{
+						_writeTrait(*entities[i], output);
+					}
+				});
+
+				size_t outputSize = comment.size();
+
+				for (const std::string& currChunk : chunks)
+				{
+					outputSize += currChunk.size();
 				}
 
-				return true;
+				std::string output;
+				output.reserve(outputSize);
+				output.append(comment);
+
+				for (const std::string& currChunk : chunks)
+				{
+					output.append(currChunk);
+				}
+
+				return mpHeaderOutputStream->WriteString(output);
 			}
 
 			template <typename T>
-			std::string WriteInclusions(const MetaExtractor<T>& metaExtractor)
+			std::string WriteInclusions(const typename MetaExtractor<T>::TTypesArray& entities)
 			{
-				auto&& entities = metaExtractor.GetTypesInfo();
-
 				std::unordered_map<std::string, std::vector<std::string>> inclusionsPerSection{};
 				std::set<std::string> includedHeaders;
 
@@ -67,7 +102,7 @@ namespace TDEngine2
 						continue;
 					}
 
-					std::string path = Wrench::StringUtils::Format("\t#include \"{0}\"\n", Wrench::StringUtils::ReplaceAll(currMetaEntity->mpOwner->GetSourceFilename(), "\\", "/"));
+					std::string path = mInclusionPattern.ToString({ Wrench::StringUtils::ReplaceAll(currMetaEntity->mpOwner->GetSourceFilename(), "\\", "/") });
 
 					if (includedHeaders.find(path) != includedHeaders.cend())
 					{
@@ -86,7 +121,7 @@ namespace TDEngine2
 
 				for (auto&& currEntry : inclusionsPerSection)
 				{
-					result.append(Wrench::StringUtils::Format("\n#ifdef META_EXPORT_{0}_SECTION\n", currEntry.first));
+					mSectionHeaderPattern.Emit(result, { currEntry.first });
 					
 					for (const std::string& currInclusionLine : currEntry.second)
 					{
@@ -102,6 +137,16 @@ namespace TDEngine2
 		private:
 			void _writeHeaderPrelude(const std::string& inclusionsPart);
 
+			void _writeTrait(const TEnumType& type, std::string& output) const;
+			void _writeTrait(const TClassType& type, std::string& output) const;
+
+			/*!
+				\brief The method calls the job for each index in [0; jobsCount). Jobs are executed on a pool of threads if it's allowed,
+				the method returns when all of them are done
+			*/
+
+			void _executeJobs(uint32_t jobsCount, const std::function<void(uint32_t)>& job) const;
+
 			static std::vector<std::string> _getParentClasses(const TClassType& classType);
 			static std::string _vectorToString(const std::vector<std::string>& types);
 
@@ -115,18 +160,25 @@ namespace TDEngine2
 
 			std::string                    mOutputFilenamesName;
 
-			static const std::string       mEnumeratorFieldPattern;
-			static const std::string       mClassTypeFieldPattern;
+			static const CodeTemplate      mEnumeratorFieldPattern;
+			static const CodeTemplate      mClassTypeFieldPattern;
+
+			static const CodeTemplate      mClassTraitTemplateSpecializationHeaderPattern;
 
-			static const std::string       mClassTraitTemplateSpecializationHeaderPattern;
+			static const CodeTemplate      mSectionHeaderPattern;
+			static const CodeTemplate      mInclusionPattern;
 
 			static const std::string       mTrueConstant;
 			static const std::string       mFalseConstant;
 
+			static constexpr uint32_t      mChunksPerThread = 4; // \note Types are split into more chunks than threads to balance uneven traits
+
 			E_EMIT_FLAGS                   mEmitFlags;
 
 			std::vector<std::regex>        mTypenamesToHidePatterns;
 
 			bool                           mIsTaggedOnlyMode = false;
+
+			uint32_t                       mThreadsCount = 1;
 	};
 }
\ No newline at end of file
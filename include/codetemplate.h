@@ -0,0 +1,56 @@
+#pragma once
+
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <initializer_list>
+
+
+namespace TDEngine2
+{
+	/*!
+		class CodeTemplate
+
+		\brief The class is a pattern with {N} placeholders that's parsed once into a list of segments. Each segment is either
+		a span of literal text or a slot of an argument. Emitting the pattern doesn't scan it again, it reserves the exact size
+		of the result and appends segments into the destination buffer. Placeholders with indices greater than a number of passed
+		arguments are written as is
+	*/
+
+	class CodeTemplate
+	{
+		public:
+			explicit CodeTemplate(std::string_view pattern);
+
+			/*!
+				\brief The method appends the pattern into the output, placeholders are replaced with corresponding arguments
+			*/
+
+			void Emit(std::string& output, std::initializer_list<std::string_view> args) const;
+
+			std::string ToString(std::initializer_list<std::string_view> args) const;
+
+			/*!
+				\brief The method returns a size of the pattern without placeholders
+			*/
+
+			size_t GetLiteralsSize() const;
+		private:
+			static constexpr uint32_t mLiteralSegmentId = (std::numeric_limits<uint32_t>::max)();
+
+			struct TSegment
+			{
+				uint32_t mOffset;
+				uint32_t mSize;
+				uint32_t mArgIndex; ///< Equals to mLiteralSegmentId for literal spans
+			};
+		private:
+			std::string           mPattern;
+			std::vector<TSegment> mSegments;
+
+			size_t                mLiteralsSize = 0;
+	};
+}
@@ -12,6 +12,8 @@
 #include <unordered_map>
 #include <mutex>
 #include <regex>
+#include "stringpool.h"
+#include "hash.h"
 
 
 namespace TDEngine2
@@ -53,6 +55,7 @@ namespace TDEngine2
 		bool                      mIsTaggedOnlyModeEnabled = false;
 		bool                      mIsLogOutputEnabled = true;
 		bool                      mIsForceModeEnabled = false;
+		bool                      mIsPackedCacheEnabled = false;
 
 #ifdef _DEBUG
 		bool                      mIsWaitDebuggerModeEnabled = false;
@@ -61,9 +64,11 @@ namespace TDEngine2
 		std::vector<std::string>  mInputSources { "." };
 		std::vector<std::string>  mPathsToExclude;
 		std::vector<std::regex>   mTypenamesPatternsToExclude;
+		std::string               mTypenamesPatternsToExcludeStr; ///< Source string of the patterns, regular expressions can't be compared
 
 		std::string               mCacheDirname = "./cache/";
 		std::string               mCacheIndexFilename = "index.cache";
+		std::string               mCachePackFilename = "symtables.pack";
 
 		std::string               mOutputDirname = ".";
 		std::string               mOutputFilename = "metadata.h";
@@ -136,16 +141,45 @@ namespace TDEngine2
 	}
 
 
+	/*!
+		struct TFileStamp
+
+		\brief The type contains raw attributes of a file that are cheap to get via stat(). If none of them has changed
+		since the last run, the file's content is assumed to be the same and it isn't read at all
+	*/
+
+	struct TFileStamp
+	{
+		uint64_t mSize = 0;
+		int64_t  mModificationTime = 0; ///< Nanoseconds on platforms that provide them
+		uint64_t mInode = 0;            ///< Always zero on Windows
+	};
+
+	inline bool operator== (const TFileStamp& left, const TFileStamp& right)
+	{
+		return left.mSize == right.mSize && left.mModificationTime == right.mModificationTime && left.mInode == right.mInode;
+	}
+
+	inline bool operator!= (const TFileStamp& left, const TFileStamp& right) { return !(left == right); }
+
+
+	struct TSymTableCacheEntry
+	{
+		TFileStamp mStamp;
+		THash128   mContentHash;
+	};
+
+
 	class TCacheData
 	{
 		public:
-			using TCacheIndexTable = std::unordered_map<std::string, std::string>;
+			using TCacheIndexTable = std::unordered_map<std::string, TSymTableCacheEntry>;
 
 		public:
 			/*!
 				\brief The function returns an index of cached symbols per file. The key of the table
-				is a full header's path, the value is a name of corresponding cache file. The name is
-				SHA-256 hashsum
+				is a full header's path, the value contains the file's stamp and a hash of its content.
+				The index is discarded if it was written in another format
 			*/
 
 			bool Load(const std::string& cacheSourceDirectory, const std::string& cacheFilename);
@@ -158,20 +192,35 @@ namespace TDEngine2
 
 			void Reset();
 
-			void AddSymTableEntity(const std::string& filePath, const std::string& fileHash);
+			void AddSymTableEntity(const std::string& filePath, const TSymTableCacheEntry& entry);
 
-			bool Contains(const std::string& filePath, const std::string& fileHash) const;
+			bool FindSymTableEntity(const std::string& filePath, TSymTableCacheEntry& outEntry) const;
 
 			void SetInputHash(const std::string& hash);
 			void SetSymTablesIndex(TCacheIndexTable&& table);
 
+			/*!
+				\brief The method stores a digest of the last run that has completed and a stamp of the file it has written.
+				If both are the same for the next run, the output is up to date and the run could be skipped at all
+			*/
+
+			void SetLastRunInfo(const THash128& runDigest, const TFileStamp& outputStamp);
+
 			const TCacheIndexTable& GetSymTablesIndex() const;
 			const std::string& GetInputHash() const;
+
+			const THash128& GetLastRunDigest() const;
+			const TFileStamp& GetLastOutputStamp() const;
 		private:
+			static constexpr uint32_t mFormatVersion = 0x54444504; ///< Changed each time the layout of the index is changed
+
 			mutable std::mutex mMutex;
 
 			std::string mInputHash;
 
+			THash128    mLastRunDigest {};
+			TFileStamp  mLastOutputStamp {};
+
 			TCacheIndexTable mSymTablesTable;
 	};
 
@@ -181,7 +230,29 @@ namespace TDEngine2
 	*/
 
 	std::string GetHashFromInputFiles(const std::vector<std::string>& inputFiles);
-	std::string GetHashFromFilePath(const std::string& value);
+
+	bool GetFileStamp(const std::string& filePath, TFileStamp& outStamp);
+
+	/*!
+		\brief The function returns a hash of the file's content. An empty hash is returned if the file can't be read
+	*/
+
+	THash128 GetHashFromFileContent(const std::string& filePath);
+
+	/*!
+		\brief The function returns a name of a file with a cached symbol table. The name depends on both the path and the content,
+		because the symbol table stores the path of its source file
+	*/
+
+	std::string GetSymTableCacheFilename(const std::string& filePath, const THash128& contentHash);
+
+	/*!
+		\brief The function computes a digest of everything that generated code depends on: the tool's version, options
+		that change the output, a set of headers and hashes of their content from the index. False is returned if some
+		header hasn't got an entry within the index yet
+	*/
+
+	bool ComputeRunDigest(const TIntrospectorOptions& options, const std::vector<std::string>& headers, const TCacheData& cacheData, THash128& outDigest);
 
 
 	enum class E_SERIALIZATION_ATTRIBUTES_FLAGS : uint8_t
@@ -226,7 +297,7 @@ namespace TDEngine2
 	struct TFieldMetaTagParams
 	{
 		std::string mName = "";
-		std::string mOriginalName = "";
+		TAtom       mOriginalName;
 		bool        mIsSerializable = false;
 	};
 
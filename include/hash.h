@@ -0,0 +1,42 @@
+#pragma once
+
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+namespace TDEngine2
+{
+	/*!
+		struct THash128
+
+		\brief The type is a 128-bit hash value that's split into two 64-bit words
+	*/
+
+	struct THash128
+	{
+		uint64_t mLow = 0;
+		uint64_t mHigh = 0;
+
+		/*!
+			\brief The method returns the hash as a string of 32 hexadecimal digits, the high word goes first
+		*/
+
+		std::string ToString() const;
+	};
+
+	inline bool operator== (const THash128& left, const THash128& right) { return left.mLow == right.mLow && left.mHigh == right.mHigh; }
+	inline bool operator!= (const THash128& left, const THash128& right) { return !(left == right); }
+
+
+	/*!
+		\brief The function computes a fast non-cryptographic 128-bit hash of the data. It's the x64 variant of MurmurHash3 which
+		processes the input in 16-byte blocks with two independent lanes, so it's not suitable to protect against malicious inputs
+	*/
+
+	THash128 ComputeHash128(const void* pData, size_t size, uint64_t seed = 0);
+
+	inline THash128 ComputeHash128(std::string_view data, uint64_t seed = 0) { return ComputeHash128(data.data(), data.size(), seed); }
+}
@@ -2,12 +2,16 @@
 
 
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <unordered_map>
+#include <array>
+#include <vector>
 #include <memory>
 #include <optional>
 #include "tokens.h"
 #include "common.h"
+#include "scanners.h"
 
 
 namespace TDEngine2
@@ -22,6 +26,13 @@ namespace TDEngine2
 			virtual bool Close() TDE2_NOEXCEPT = 0;
 
 			virtual std::string ReadLine() TDE2_NOEXCEPT = 0;
+
+			/*!
+				\brief The method returns a view of the whole stream's content if the implementation keeps it in memory.
+				An empty view means that the data should be read line by line via ReadLine
+			*/
+
+			virtual std::string_view GetContents() const TDE2_NOEXCEPT { return std::string_view(); }
 	};
 
 
@@ -45,27 +56,120 @@ namespace TDEngine2
 	};
 
 
-	class Lexer
+	/*!
+		class MemoryMappedInputStream
+
+		\brief The implementation maps the whole file into the address space of the process, so
+		the lexer can walk over its content without any intermediate copies
+	*/
+
+	class MemoryMappedInputStream : public IInputStream
 	{
 		public:
-			using TKeywordsMap = std::unordered_map<std::string, E_TOKEN_TYPE>;
+			MemoryMappedInputStream(const std::string& filename) TDE2_NOEXCEPT;
+			virtual ~MemoryMappedInputStream() TDE2_NOEXCEPT;
+
+			bool Open() TDE2_NOEXCEPT override;
+			bool Close() TDE2_NOEXCEPT override;
+
+			std::string ReadLine() TDE2_NOEXCEPT override;
+
+			std::string_view GetContents() const TDE2_NOEXCEPT override;
+		protected:
+			MemoryMappedInputStream() TDE2_NOEXCEPT = default;
+		protected:
+			std::string              mFilename;
+
+			const char*              mpData = nullptr;
+			size_t                   mSize = 0;
+			size_t                   mReadPosition = 0;
+
+			bool                     mIsOpened = false;
+
+#if defined(_WIN32)
+			void*                    mpFileHandle = nullptr;
+			void*                    mpMappingHandle = nullptr;
+#endif
+	};
+
+
+	/*!
+		\brief The function does a raw substring search of ENUM_META, CLASS_META and INTERFACE_META markers without tokenization.
+		It could return false positives (markers within comments or strings), but never skips a marked header
+	*/
+
+	bool HasTypesMetaMarkers(std::string_view sourceText);
+
+
+	/*!
+		struct TTokensStorage
+
+		\brief The structure contains all tokens of a file which are stored as separate arrays of their properties.
+		Tokens are scanned in mode neutral way (meta tags keywords are recognized, >> is a single token). The modes
+		are resolved later when a token is fetched by the lexer. Bodies of functions aren't tokenized at all, only
+		their braces are stored
+	*/
+
+	struct TTokensStorage
+	{
+		std::vector<E_TOKEN_TYPE> mTypes;
+		std::vector<uint32_t>     mOffsets;
+		std::vector<uint32_t>     mLengths;
+		std::vector<uint32_t>     mMatchingTokenIndices; // \note For { and ( it's an index of the matching closing token or of EOF, other tokens have zeros
+
+		size_t GetSize() const { return mTypes.size(); }
+	};
+
+
+	class Lexer
+	{
 		public:
 			explicit Lexer(IInputStream& streamSource);
 			~Lexer() = default;
 
 			const TToken& GetCurrToken();
 			const TToken& GetNextToken();
+			/*!
+				\brief The method returns a token that's placed at given offset after the current one without consuming it.
+				The offset should be less than mTokensBufferCapacity, zero offset corresponds to the current token
+			*/
+
 			const TToken& PeekToken(uint32_t offset = 1);
 
 			void SetTemplateArgsParsingMode(bool state);
 			void SetMetaTagParsingMode(bool state);
 
+			/*!
+				\brief The method skips everything till a closing brace or parenthes that matches the current token without
+				building tokens. Comments, literals and macros are taken into account. The closing token becomes the current one.
+				Returns false if the current token is neither { nor ( or if the end of the stream was reached
+			*/
+
+			bool SkipBalancedTokens();
+
+			/*!
+				\brief The method scans all the rest tokens of the stream in a single pass. After that all Get/Peek methods
+				read tokens from the storage instead of scanning the text
+			*/
+
+			void TokenizeAll();
+
+			const TTokensStorage& GetTokensStorage() const;
+
+			/*!
+				\brief The method converts a byte offset into (column, line) pair, both values start from 1.
+				An index of lines is built on the first call, so use the method only when a position is really needed (e.g. errors reporting)
+			*/
+
+			TToken::TCursorPos GetCursorPosition(uint32_t offset);
+
 		private:
 			Lexer() = default;
 
 			TToken _scanToken();			
 			TToken _skipIgnoredTokensSection();
 			TToken _getNextTokenImpl();
+			TToken _fetchNextToken();
 
 			char _getCurrChar() const;
 			char _getNextChar();
@@ -74,25 +178,51 @@ namespace TDEngine2
 			void _skipWhitespaces();
 
 			std::optional<TToken> _parseNumbers();
-			std::optional<TToken> _parseReservedKeywordsAndIdentifiers();
+			std::optional<TToken> _parseStringLiterals(); // \note Recognizes string, raw string and character literals with their prefixes
+			TToken _parseReservedKeywordsAndIdentifiers();
+			TToken _parsePunctuators();
 
 			bool _skipComments();
 			bool _skipMacroDefinitions();
 
 			void _skipSingleLineComment();
 			void _skipMultiLineComment();
+
+			bool _skipLiteral();
+			bool _skipNonCodeText(); // \note Skips a comment, a literal or a macro definition that starts at the current character
+
+			char _skipToBalancedTextDelimiter(); // \note Returns the next brace or parenthes that's placed outside of comments, literals and macros
+			bool _skipBalancedText(char openChar, char closeChar, uint32_t depth = 1);
+
+			void _fetchSourceText();
+
+			void _moveCursorTo(const char* pNextChar);
 		private:
 			IInputStream*             mpStream;
 
-			std::string               mCurrProcessedText;
+			std::string_view          mSourceText;      // \note Either a view of the stream's contents or of mOwnedSourceText
+			std::string               mOwnedSourceText; // \note Used only for streams that don't keep their contents in memory
+			size_t                    mCursor = 0;      // \note An index of a character that follows the current one
+			bool                      mIsSourceTextFetched = false;
+
+			static constexpr uint32_t mTokensBufferCapacity = 16; // \note Should be a power of two, the value restricts the max offset of PeekToken
+
+			static_assert(!(mTokensBufferCapacity & (mTokensBufferCapacity - 1)), "The capacity of tokens buffer should be a power of two");
+
+			using TTokensBuffer = std::array<TToken, mTokensBufferCapacity>;
+
+			TTokensBuffer             mTokensBuffer;            // \note A ring buffer that contains the current token at mTokensBufferHead and lookahead tokens after it
+			uint32_t                  mTokensBufferHead = 0;
+			uint32_t                  mTokensBufferSize = 0;
 
-			std::vector<TToken>       mTokensQueue;
-			TToken                    mLastScannedToken{};
+			const TTextScannersTable* mpScanners;
 
-			uint32_t                  mCurrLineIndex = 1;
-			uint32_t                  mCurrHorPosIndex = 0;
+			std::vector<uint32_t>     mLinesStartPositions; // \note Lazily built index of lines for GetCursorPosition
 
-			static const TKeywordsMap mReservedTokens;
+			TTokensStorage            mTokensStorage;
+			size_t                    mNextStoredTokenIndex = 0;
+			bool                      mIsTokenized = false;
+			bool                      mIsSplitTokenPending = false; // \note It's true if a half of >> token should be fetched next
 
 			bool                      mIsTemplateArgsParsingModeEnabled = false;
 			bool                      mIsMetaTagParsingModeEnabled = false;
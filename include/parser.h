@@ -69,7 +69,7 @@ namespace TDEngine2
 				ALL = ENUM_TYPE | TYPE | NAMESPACE | TEMPLATE
 			};
 
-			typedef Wrench::Result<std::shared_ptr<struct TType>, bool> TTypeResult;
+			typedef Wrench::Result<struct TType*, bool> TTypeResult;
 
 		public:
 			Parser(Lexer& lexer, SymTable& symTable, const TIntrospectorOptions& options, const TOnErrorCallback& onErrorCallback);
@@ -0,0 +1,157 @@
+#pragma once
+
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+
+namespace TDEngine2
+{
+	enum class E_SIMD_INSTRUCTIONS_SET : uint8_t
+	{
+		NONE,
+		SSE2,
+		AVX2,
+	};
+
+
+	/*!
+		\brief The type of a scanning kernel. Each kernel walks over [pBegin; pEnd) range and returns a pointer to the first character
+		that doesn't satisfy its criteria or pEnd if there is no such a character
+	*/
+
+	typedef const char* (*TScanFunction)(const char* pBegin, const char* pEnd);
+
+	/*!
+		\brief The type of a substring search kernel, it returns a pointer to the first occurrence of the pattern or pEnd if there is no one
+	*/
+
+	typedef const char* (*TFindSubstringFunction)(const char* pBegin, const char* pEnd, const char* pPattern, size_t patternLength);
+
+
+	struct TTextScannersTable
+	{
+		TScanFunction           mpSkipWhitespaces;           // \note Skips ' ', '\t', '\n', '\v', '\f' and '\r'
+		TScanFunction           mpFindLineEnd;               // \note Finds '\n'
+		TScanFunction           mpFindCommentDelimiter;      // \note Finds '*' or '/', it's used to skip multi-line comments' content
+		TScanFunction           mpFindIdentifierEnd;         // \note Finds the first character that isn't allowed in identifiers
+		TScanFunction           mpFindBalancedTextDelimiter; // \note Finds braces, parentheses, '/', '#' or quotes, it's used to skip blocks without tokenization
+		TFindSubstringFunction  mpFindSubstring;
+
+		E_SIMD_INSTRUCTIONS_SET mInstructionsSet;
+	};
+
+
+	/*!
+		\brief The function returns the best instruction set that's supported by the host CPU. The check is executed once
+	*/
+
+	E_SIMD_INSTRUCTIONS_SET GetSupportedInstructionsSet();
+
+	/*!
+		\brief The function returns kernels that are implemented with a given instructions set. If the set isn't available on the platform
+		the scalar implementation is returned. Use it directly only for tests and benchmarks, otherwise use GetTextScanners()
+	*/
+
+	const TTextScannersTable& GetTextScanners(E_SIMD_INSTRUCTIONS_SET instructionsSet);
+
+	/*!
+		\brief The function returns kernels which are selected at runtime for the host CPU
+	*/
+
+	const TTextScannersTable& GetTextScanners();
+
+
+	/*!
+		\brief The enumeration defines which kind of a token could start with a character. The lexer dispatches
+		each token's beginning with a single lookup into CharClassesTable
+	*/
+
+	enum class E_CHAR_CLASS : uint8_t
+	{
+		OTHER,
+		WHITESPACE,       // \note ' ', '\t', '\n', '\v', '\f' and '\r'
+		DIGIT,
+		IDENTIFIER_START, // \note Latin letters and '_'
+		LITERAL_PREFIX,   // \note u, U, L and R start either an identifier or a prefixed string literal
+		QUOTE,
+		DOT,              // \note Either a floating point number or a single character token
+		SLASH,            // \note Either a comment or a single character token
+		HASH,             // \note A beginning of a preprocessor directive
+		PUNCTUATOR,       // \note The first character of one of punctuators that GetPunctuatorTokenType recognizes
+	};
+
+
+	constexpr std::array<E_CHAR_CLASS, 256> BuildCharClassesTable()
+	{
+		std::array<E_CHAR_CLASS, 256> table{};
+
+		for (char ch : { ' ', '\t', '\n', '\v', '\f', '\r' })
+		{
+			table[static_cast<uint8_t>(ch)] = E_CHAR_CLASS::WHITESPACE;
+		}
+
+		for (uint32_t ch = '0'; ch <= '9'; ++ch)
+		{
+			table[ch] = E_CHAR_CLASS::DIGIT;
+		}
+
+		for (uint32_t ch = 'a'; ch <= 'z'; ++ch)
+		{
+			table[ch] = E_CHAR_CLASS::IDENTIFIER_START;
+			table[ch - 'a' + 'A'] = E_CHAR_CLASS::IDENTIFIER_START;
+		}
+
+		table['_'] = E_CHAR_CLASS::IDENTIFIER_START;
+
+		for (char ch : { 'u', 'U', 'L', 'R' })
+		{
+			table[static_cast<uint8_t>(ch)] = E_CHAR_CLASS::LITERAL_PREFIX;
+		}
+
+		table['"'] = E_CHAR_CLASS::QUOTE;
+		table['\''] = E_CHAR_CLASS::QUOTE;
+		table['.'] = E_CHAR_CLASS::DOT;
+		table['/'] = E_CHAR_CLASS::SLASH;
+		table['#'] = E_CHAR_CLASS::HASH;
+
+		for (char ch : { ':', '{', '}', '(', ')', ';', '=', ',', '<', '>', '|', '-', '+' })
+		{
+			table[static_cast<uint8_t>(ch)] = E_CHAR_CLASS::PUNCTUATOR;
+		}
+
+		return table;
+	}
+
+
+	inline constexpr std::array<E_CHAR_CLASS, 256> CharClassesTable = BuildCharClassesTable();
+
+
+	inline E_CHAR_CLASS GetCharClass(char ch)
+	{
+		return CharClassesTable[static_cast<uint8_t>(ch)];
+	}
+
+	inline bool IsWhitespace(char ch)
+	{
+		return E_CHAR_CLASS::WHITESPACE == GetCharClass(ch);
+	}
+
+	inline bool IsIdentifierStartChar(char ch)
+	{
+		const E_CHAR_CLASS charClass = GetCharClass(ch);
+		return E_CHAR_CLASS::IDENTIFIER_START == charClass || E_CHAR_CLASS::LITERAL_PREFIX == charClass;
+	}
+
+	inline bool IsDigitChar(char ch)
+	{
+		return E_CHAR_CLASS::DIGIT == GetCharClass(ch);
+	}
+
+	inline bool IsIdentifierChar(char ch)
+	{
+		const E_CHAR_CLASS charClass = GetCharClass(ch);
+		return E_CHAR_CLASS::DIGIT == charClass || E_CHAR_CLASS::IDENTIFIER_START == charClass || E_CHAR_CLASS::LITERAL_PREFIX == charClass;
+	}
+}
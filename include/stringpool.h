@@ -0,0 +1,111 @@
+#pragma once
+
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <shared_mutex>
+#include <functional>
+#include "arena.h"
+
+
+namespace TDEngine2
+{
+	/*!
+		struct TAtom
+
+		\brief The type is a handle of a string that's stored within the global StringPool. Equal strings always have equal atoms,
+		so comparison and hashing of atoms are plain integer operations. A zero value corresponds to an empty string
+	*/
+
+	struct TAtom
+	{
+		uint32_t mValue = 0;
+
+		bool IsEmpty() const { return !mValue; }
+
+		/*!
+			\brief The method returns a view of the string, it stays valid until the end of the process
+		*/
+
+		std::string_view GetString() const;
+
+		std::string ToString() const;
+	};
+
+	inline bool operator== (TAtom left, TAtom right) { return left.mValue == right.mValue; }
+	inline bool operator!= (TAtom left, TAtom right) { return left.mValue != right.mValue; }
+
+	bool operator== (TAtom atom, std::string_view str);
+	bool operator!= (TAtom atom, std::string_view str);
+
+
+	/*!
+		class StringPool
+
+		\brief The class is a process-wide storage of unique strings. It's split into shards that are guarded by their own locks,
+		so workers that parse different files rarely contend with each other. Strings are never removed from the pool
+	*/
+
+	class StringPool
+	{
+		public:
+			static StringPool& Get();
+
+			StringPool(const StringPool&) = delete;
+			StringPool& operator= (const StringPool&) = delete;
+
+			/*!
+				\brief The method returns an atom of the string. The string is added into the pool if it's met at the first time
+			*/
+
+			TAtom Intern(std::string_view str);
+
+			/*!
+				\brief The method returns an atom of the string only if the pool already contains it, otherwise an empty atom is returned
+			*/
+
+			TAtom Find(std::string_view str) const;
+
+			std::string_view GetString(TAtom atom) const;
+
+			size_t GetSize() const;
+		private:
+			StringPool() = default;
+		private:
+			static constexpr uint32_t mShardsCountLog2 = 4;
+			static constexpr uint32_t mShardsCount = 1 << mShardsCountLog2;
+
+			struct TShard
+			{
+				mutable std::shared_mutex                      mMutex;
+
+				std::unordered_map<std::string_view, uint32_t> mStringsTable; // \note Keys point into mArena
+				std::vector<std::string_view>                  mStrings;
+
+				MemoryArena                                    mArena;
+			};
+		private:
+			std::array<TShard, mShardsCount> mShards;
+	};
+
+
+	/*!
+		\brief The function is a shortcut for StringPool::Get().Intern(str)
+	*/
+
+	TAtom InternString(std::string_view str);
+}
+
+
+namespace std
+{
+	template <>
+	struct hash<TDEngine2::TAtom>
+	{
+		size_t operator()(TDEngine2::TAtom atom) const { return std::hash<uint32_t>{}(atom.mValue); }
+	};
+}
@@ -2,22 +2,27 @@
 
 
 #include <string>
+#include <string_view>
+#include <limits>
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <array>
+#include <mutex>
+#include <algorithm>
 #include <fstream>
 #include "common.h"
-
-
-template<typename T> class Archive;
+#include "arena.h"
+#include "stringpool.h"
 
 
 namespace TDEngine2
 {
 	class ITypeVisitor;
 	class SymTable;
-	using FileReaderArchive = Archive<std::ifstream>;
-	using FileWriterArchive = Archive<std::ofstream>;
+	class SymTableView;
+	class BufferReaderArchive;
+	class BufferWriterArchive;
 
 
 	enum class E_ACCESS_SPECIFIER_TYPE : uint8_t
@@ -39,24 +44,22 @@ namespace TDEngine2
 			UNKNOWN
 		};
 
-		using UniquePtr = std::unique_ptr<TType>;
-		using Ptr       = std::shared_ptr<TType>;
-		using WeakPtr   = std::weak_ptr<TType>;
+		using Ptr = TType*; // \note All types are owned by an arena of SymTable that has created them
 
 		virtual ~TType() = default;
 
-		static bool SafeSerialize(FileWriterArchive& archive, TType* pType);
-		static std::unique_ptr<TType> Deserialize(FileReaderArchive& archive, SymTable* pSymTable = nullptr);
+		static bool SafeSerialize(BufferWriterArchive& archive, TType* pType);
+		static TType* Deserialize(BufferReaderArchive& archive, SymTable& symTable);
 
-		virtual bool Load(FileReaderArchive& archive);
-		virtual bool Save(FileWriterArchive& archive);
+		virtual bool Load(BufferReaderArchive& archive);
+		virtual bool Save(BufferWriterArchive& archive);
 
 		virtual void Visit(ITypeVisitor& visitor) const;
 
 		virtual E_SUBTYPE GetSubtype() const { return E_SUBTYPE::BASE; }
 
-		std::string mId;
-		std::string mMangledId; // \note contains full path to type Namespace..ClassName@Type
+		TAtom mId;
+		TAtom mMangledId; // \note contains full path to type Namespace..ClassName@Type
 
 		/*!
 			\brief The identifier works as module's name to group metadata into parts and export declarations partially
@@ -78,7 +81,7 @@ namespace TDEngine2
 
 		SymTable* mpOwner = nullptr;
 
-		WeakPtr mpParentType{};
+		TType* mpParentType = nullptr;
 
 		E_ACCESS_SPECIFIER_TYPE mAccessModifier = E_ACCESS_SPECIFIER_TYPE::PUBLIC;
 
@@ -100,12 +103,14 @@ namespace TDEngine2
 	{
 		virtual ~TEnumType() = default;
 
-		bool Load(FileReaderArchive& archive) override;
-		bool Save(FileWriterArchive& archive) override;
+		bool Load(BufferReaderArchive& archive) override;
+		bool Save(BufferWriterArchive& archive) override;
 
 		void Visit(ITypeVisitor& visitor) const override;
 
-		E_SUBTYPE GetSubtype() const override { return E_SUBTYPE::ENUM; }
+		static constexpr E_SUBTYPE mSubtype = E_SUBTYPE::ENUM;
+
+		E_SUBTYPE GetSubtype() const override { return mSubtype; }
 
 		bool                     mIsStronglyTyped = false;
 		bool                     mIsIntrospectable = false;
@@ -119,11 +124,11 @@ namespace TDEngine2
 
 	struct TClassType : TType
 	{
-		using Ptr = std::shared_ptr<TClassType>;
+		using Ptr = TClassType*;
 
 		struct TBaseClassInfo
 		{
-			std::string mFullName; /// Includes full path with namespaces 
+			TAtom mFullName; /// Includes full path with namespaces 
 
 			bool mIsVirtualInherited = false;
 			
@@ -132,12 +137,14 @@ namespace TDEngine2
 
 		virtual ~TClassType() = default;
 
-		bool Load(FileReaderArchive& archive) override;
-		bool Save(FileWriterArchive& archive) override;
+		bool Load(BufferReaderArchive& archive) override;
+		bool Save(BufferWriterArchive& archive) override;
 
 		void Visit(ITypeVisitor& visitor) const override;
 
-		E_SUBTYPE GetSubtype() const override { return E_SUBTYPE::CLASS; }
+		static constexpr E_SUBTYPE mSubtype = E_SUBTYPE::CLASS;
+
+		E_SUBTYPE GetSubtype() const override { return mSubtype; }
 
 		bool mIsFinal = false;
 		bool mIsStruct = false;
@@ -169,31 +176,79 @@ namespace TDEngine2
 	class SymTable
 	{
 		public:
+			/*!
+				struct TScopeEntity
+
+				\brief All scopes of a table are stored within a single array. A hierarchy is expressed via indices of
+				the parent, the first child and the next sibling, so children of a scope are listed in order of their creation
+			*/
+
 			struct TScopeEntity
 			{
-				using Ptr = std::unique_ptr<TScopeEntity>;
+				static constexpr uint32_t mInvalidIndex = (std::numeric_limits<uint32_t>::max)();
+
+				bool Save(BufferWriterArchive& archive) const;
+				bool Load(BufferReaderArchive& archive, SymTable& symTable);
+
+				bool IsNamed() const { return !mName.IsEmpty(); }
 
-				bool Save(FileWriterArchive& archive);
-				bool Load(FileReaderArchive& archive, SymTable* symTable);
+				/*!
+					\brief The method returns a symbol with the given name or nullptr. Small scopes are scanned linearly,
+					the bigger ones use an index that is built on demand
+				*/
 
-				TScopeEntity*                        mpParentScope = nullptr;
+				const TSymbolDesc* FindSymbol(std::string_view name) const;
 
-				std::vector<Ptr>                     mpNestedScopes{};
+				/*!
+					\brief The method appends a new symbol or updates a type of an existing one with the same name
+				*/
 
-				std::unordered_map<std::string, Ptr> mpNamedScopes{};
+				void UpsertSymbol(TSymbolDesc&& desc);
 
-				std::vector<TSymbolDesc>             mVariables{};
+				TAtom                                mName; // \note Empty for anonymous scopes and the global one
+				TAtom                                mMangledId; // \note Full path of a named scope Namespace@ClassName@Name, anonymous scopes inherit their parents' ids
+
+				uint32_t                             mParentIndex = mInvalidIndex;
+				uint32_t                             mFirstChildIndex = mInvalidIndex;
+				uint32_t                             mLastChildIndex = mInvalidIndex;
+				uint32_t                             mNextSiblingIndex = mInvalidIndex;
+
+				uint32_t                             mAnonymousScopesCount = 0;
+
+				std::vector<TSymbolDesc>             mVariables{}; // \note Keeps the insertion order, so serialization is deterministic
 
 				int32_t                              mIndex = -1; // -1 for all named scopes
 
-				TType::Ptr                           mpType = nullptr; // for anonymous scopes it's nullptr
+				TType*                               mpType = nullptr; // for anonymous scopes it's nullptr, use SymTable::SetScopeType to change it
+
+				private:
+					static constexpr uint32_t mSymbolsIndexThreshold = 16; // \note The index is built only for scopes with more symbols than the value
+
+					int32_t _findSymbolIndex(std::string_view name) const;
+
+					void _updateSymbolsIndex() const;
+					void _insertIntoSymbolsIndex(uint32_t symbolIndex, uint32_t hash) const;
+
+				private:
+					/// \note An open addressing table with linear probing over mVariables. Each slot keeps a hash of a name in the high
+					/// half and the symbol's index plus one in the low half, zero marks an empty slot. It's updated lazily by lookups
+					mutable std::vector<uint64_t>        mSymbolsIndex{};
+					mutable uint32_t                     mIndexedSymbolsCount = 0;
 			};
 		public:
 			SymTable();
 			~SymTable();
 
-			bool Save(FileWriterArchive& archive);
-			bool Load(FileReaderArchive& archive);
+			SymTable(const SymTable&) = delete;
+			SymTable& operator= (const SymTable&) = delete;
+
+			bool Save(BufferWriterArchive& archive);
+			bool Load(BufferReaderArchive& archive);
+
+			/*!
+				\brief The method walks over all scopes in order of their creation without any recursion. Named scopes are passed into
+				VisitNamedScope, the rest ones into VisitScope
+			*/
 
 			void Visit(ISymTableVisitor& visitor);
 
@@ -206,30 +261,85 @@ namespace TDEngine2
 
 			const TSymbolDesc& LookUpSymbol(const std::string& id) const;
 
+			/*!
+				\brief The method looks for a named scope starting from the current one and up to the global scope.
+				The returned pointer stays valid until a new scope is created
+			*/
+
 			TScopeEntity* LookUpNamedScope(const std::string& name);
 
 			void SetSourceFilename(const std::string& filename);
 
-			std::string GetMangledNameForNamedScope(const std::string& id);
+			/*!
+				\brief The method returns a mangled id of a named scope that's visible from the current one. The id is computed
+				once when the scope is created, so the call costs the same as LookUpNamedScope
+			*/
+
+			TAtom GetMangledNameForNamedScope(const std::string& id);
 
 			const std::string& GetSourceFilename() const;
 
-			TType::Ptr GetCurrScopeType() const;
-			TType::Ptr GetParentScopeType() const;
+			TType* GetCurrScopeType() const;
+			TType* GetParentScopeType() const;
+
+			/*!
+				\brief The method allocates a new type within the table's arena. The type lives until the table is destroyed or reloaded
+			*/
+
+			template <typename T>
+			T* CreateType()
+			{
+				static_assert(std::is_base_of_v<TType, T>, "T should be derived from TType");
+
+				T* pType = mArena.Create<T>();
+				pType->mpOwner = this;
+
+				return pType;
+			}
+
+			/*!
+				\brief The method attaches the type to the scope and registers the scope within a list of scopes of the same kind,
+				so types could be extracted without traversal of the whole table
+			*/
+
+			void SetScopeType(TScopeEntity& scope, TType* pType);
+
+			/*!
+				\brief The method returns indices of scopes that have got types of the given kind in order of registration.
+				A scope's type could be replaced later, so check its subtype before using it
+			*/
+
+			const std::vector<uint32_t>& GetTypedScopes(TType::E_SUBTYPE subtype) const;
+
+			const TScopeEntity& GetScope(uint32_t index) const;
+			size_t GetScopesCount() const;
+		private:
+			using TNamedScopesTable = std::unordered_map<uint64_t, uint32_t>; // \note A key consists of a parent's index and an atom of a name
+
+			static uint64_t _getNamedScopeKey(uint32_t parentIndex, TAtom name) { return (static_cast<uint64_t>(parentIndex) << 32) | name.mValue; }
 		private:
 			void _reset();
 
-			bool _createAnonymousScope();
-			bool _createNamedScope(const std::string& name);
+			bool _createScope(TAtom name);
+			void _linkScope(uint32_t scopeIndex);
+			void _registerTypedScope(uint32_t scopeIndex, TType::E_SUBTYPE prevSubtype);
 
 			bool _visitAnonymousScope();
 			bool _visitNamedScope(const std::string& name);
 
+			uint32_t _findNamedScope(uint32_t parentIndex, TAtom name) const;
+
 			const TSymbolDesc& _lookUpInternal(const std::string& id) const;
 		private:
-			TScopeEntity::Ptr mpGlobalScope;
-			TScopeEntity*     mpCurrScope;
-			TScopeEntity*     mpPrevScope;
+			MemoryArena               mArena; // \note Owns all types, so they're released at once
+
+			std::vector<TScopeEntity> mScopes; // \note The global scope is always placed first
+			TNamedScopesTable         mNamedScopesTable; // \note (parent's index, name) -> scope's index
+
+			std::array<std::vector<uint32_t>, static_cast<size_t>(TType::E_SUBTYPE::UNKNOWN)> mTypedScopesPerKind;
+
+			uint32_t                  mCurrScopeIndex = 0;
+			uint32_t                  mPrevScopeIndex = 0;
 
 			bool          mIsReadOnlyMode = false; // \note It's set to true if EnterScope is used
 
@@ -279,7 +389,7 @@ namespace TDEngine2
 	{
 		public:
 			using TTypesArray = std::vector<const Type*>;
-			using TTypesHashMap = std::unordered_map<std::string, uint32_t>; // key is a full name of an entity which is consists of mangled name like the following Name@..@TypeName
+			using TTypesHashMap = std::unordered_map<TAtom, uint32_t>; // key is a full name of an entity which is consists of mangled name like the following Name@..@TypeName
 		
 		public:
 			MetaExtractor(const E_EMIT_FLAGS& flags) :
@@ -289,35 +399,34 @@ namespace TDEngine2
 
 			virtual ~MetaExtractor() = default;
 
-			void VisitScope(const SymTable::TScopeEntity& scope) override
+			/*!
+				\brief The method collects types only from scopes that are registered with Type's kind. It's cheaper than
+				SymTable::Visit which walks all scopes of the table
+			*/
+
+			void Extract(const SymTable& symTable)
 			{
-				for (auto&& pCurrScope : scope.mpNestedScopes)
+				for (const uint32_t currScopeIndex : symTable.GetTypedScopes(Type::mSubtype))
 				{
-					VisitScope(*pCurrScope);
-				}
+					const TType* pScopeType = symTable.GetScope(currScopeIndex).mpType;
 
-				for (auto&& currNamedScope : scope.mpNamedScopes)
-				{
-					VisitNamedScope(*currNamedScope.second);
+					if (pScopeType && Type::mSubtype == pScopeType->GetSubtype())
+					{
+						pScopeType->Visit(*this);
+					}
 				}
 			}
 
+			void VisitScope(const SymTable::TScopeEntity& scope) override
+			{
+			}
+
 			void VisitNamedScope(const SymTable::TScopeEntity& namedScope) override
 			{
-				if (TType* pScopeType = namedScope.mpType.get()) // \note this scope isn't namespace probably class, struct or enum
+				if (TType* pScopeType = namedScope.mpType) // \note this scope isn't namespace probably class, struct or enum
 				{
 					pScopeType->Visit(*this);
 				}
-
-				for (auto&& pCurrScope : namedScope.mpNestedScopes)
-				{
-					VisitScope(*pCurrScope);
-				}
-
-				for (auto&& currNamedScope : namedScope.mpNamedScopes)
-				{
-					VisitNamedScope(*currNamedScope.second);
-				}
 			}
 
 			void VisitBaseType(const TType& type) override {}
@@ -327,9 +436,33 @@ namespace TDEngine2
 
 			const TTypesArray& GetTypesInfo() const { return mpTypesInfo; }
 
+			/*!
+				\brief The method returns true if a candidate should replace the current type with the same mangled id.
+				The candidate is assumed to be met later than the current one
+			*/
+
+			virtual bool ShouldReplace(const Type& currType, const Type& candidateType) const = 0;
+
 		protected:
 			MetaExtractor() = default;
 
+			void _addType(const Type& type)
+			{
+				auto iter = mTypesHashTable.find(type.mMangledId);
+				if (iter == mTypesHashTable.cend())
+				{
+					mTypesHashTable.emplace(type.mMangledId, static_cast<uint32_t>(mpTypesInfo.size()));
+					mpTypesInfo.push_back(&type);
+
+					return;
+				}
+
+				if (ShouldReplace(*mpTypesInfo[iter->second], type))
+				{
+					mpTypesInfo[iter->second] = &type; // \note The type keeps the position of its first occurrence
+				}
+			}
+
 		protected:
 			TTypesHashMap mTypesHashTable;
 			TTypesArray   mpTypesInfo;
@@ -350,9 +483,21 @@ namespace TDEngine2
 			EnumsMetaExtractor(const E_EMIT_FLAGS& flags);
 			virtual ~EnumsMetaExtractor() = default;
 
+			using MetaExtractor<TEnumType>::Extract;
+
+			/*!
+				\brief The method filters enums of a cached table in place, types are created within typesOwner only for passed records
+			*/
+
+			void Extract(const SymTableView& view, SymTable& typesOwner);
+
 			void VisitEnumType(const TEnumType& type) override;
+
+			bool ShouldReplace(const TEnumType& currType, const TEnumType& candidateType) const override; // \note A defined enum wins over a forward declaration
 		private:
 			EnumsMetaExtractor() = default;
+
+			bool _shouldExtract(E_ACCESS_SPECIFIER_TYPE accessModifier, bool hasTemplateParent) const;
 	};
 
 
@@ -366,8 +511,116 @@ namespace TDEngine2
 			ClassMetaExtractor(const E_EMIT_FLAGS& flags);
 			virtual ~ClassMetaExtractor() = default;
 
+			using MetaExtractor<TClassType>::Extract;
+
+			/*!
+				\brief The method filters classes of a cached table in place, types are created within typesOwner only for passed records
+			*/
+
+			void Extract(const SymTableView& view, SymTable& typesOwner);
+
 			void VisitClassType(const TClassType& type) override;
+
+			bool ShouldReplace(const TClassType& currType, const TClassType& candidateType) const override; // \note The latest definition wins
 		private:
 			ClassMetaExtractor() = default;
+
+			bool _shouldExtract(bool isStruct, bool isTemplate, E_ACCESS_SPECIFIER_TYPE accessModifier, bool hasNonPublicParent) const;
+	};
+
+
+	/*!
+		class MetaTypesMergeTable
+
+		\brief The class merges outputs of extractors that are run over different symbol tables concurrently. The table is split
+		into shards with their own locks. Each type gets an order key that consists of an index of its symbol table and its position
+		within the extractor's output, so the merged result doesn't depend on the order in which extractors have been merged
+	*/
+
+	template <typename Type>
+	class MetaTypesMergeTable
+	{
+		public:
+			using TTypesArray = typename MetaExtractor<Type>::TTypesArray;
+		public:
+			void Merge(const MetaExtractor<Type>& extractor, uint32_t symTableIndex)
+			{
+				auto&& types = extractor.GetTypesInfo();
+
+				for (uint32_t i = 0; i < static_cast<uint32_t>(types.size()); ++i)
+				{
+					const Type* pType = types[i];
+					const uint64_t order = (static_cast<uint64_t>(symTableIndex) << 32) | i;
+
+					TShard& shard = mShards[std::hash<TAtom>{}(pType->mMangledId) & (mShardsCount - 1)];
+
+					std::lock_guard<std::mutex> lock(shard.mMutex);
+
+					auto iter = shard.mEntries.find(pType->mMangledId);
+					if (iter == shard.mEntries.end())
+					{
+						shard.mEntries.emplace(pType->mMangledId, TEntry{ order, order, pType });
+						continue;
+					}
+
+					TEntry& entry = iter->second;
+
+					entry.mFirstOrder = (std::min)(entry.mFirstOrder, order);
+
+					/// \note Apply the same rule as if types were met sequentially, so an earlier candidate wins only if the current one would be replaced by it
+					const bool shouldReplace = (order > entry.mWinnerOrder) ? extractor.ShouldReplace(*entry.mpWinner, *pType) : !extractor.ShouldReplace(*pType, *entry.mpWinner);
+					if (shouldReplace)
+					{
+						entry.mWinnerOrder = order;
+						entry.mpWinner = pType;
+					}
+				}
+			}
+
+			/*!
+				\brief The method returns merged types in order of their first occurrences. Don't call it while merges are in progress
+			*/
+
+			TTypesArray GetTypes() const
+			{
+				std::vector<std::pair<uint64_t, const Type*>> orderedTypes;
+
+				for (const TShard& currShard : mShards)
+				{
+					for (auto&& currEntry : currShard.mEntries)
+					{
+						orderedTypes.emplace_back(currEntry.second.mFirstOrder, currEntry.second.mpWinner);
+					}
+				}
+
+				std::sort(orderedTypes.begin(), orderedTypes.end(), [](auto&& left, auto&& right) { return left.first < right.first; });
+
+				TTypesArray types;
+				types.reserve(orderedTypes.size());
+
+				for (auto&& currEntry : orderedTypes)
+				{
+					types.push_back(currEntry.second);
+				}
+
+				return types;
+			}
+		private:
+			struct TEntry
+			{
+				uint64_t    mFirstOrder;
+				uint64_t    mWinnerOrder;
+				const Type* mpWinner;
+			};
+
+			struct TShard
+			{
+				std::mutex                        mMutex;
+				std::unordered_map<TAtom, TEntry> mEntries;
+			};
+
+			static constexpr uint32_t mShardsCount = 16;
+		private:
+			std::array<TShard, mShardsCount> mShards;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <memory>
+#include "symtable.h"
+#include "lexer.h"
+
+
+namespace TDEngine2
+{
+	/*!
+		class SymTableView
+
+		\brief The class provides read-only access to enums and classes of a serialized symbol table without its deserialization.
+		The layout is relocatable, all references are offsets from the beginning of the data, so the view could be created over
+		a memory-mapped cache file. Only types are stored, scopes and symbols aren't needed to generate meta-information.
+
+		| Header | Enums | Classes | Enumerators | Base classes | Fields | Strings |
+
+		Records of types keep data of their parents that's used by extractors, so they could be filtered in place
+	*/
+
+	class SymTableView
+	{
+		public:
+			struct TStringRef
+			{
+				uint32_t mOffset; ///< Offset from the beginning of the strings table
+				uint32_t mSize;
+			};
+
+			struct TArrayRef
+			{
+				uint32_t mOffset; ///< Offset from the beginning of the data
+				uint32_t mCount;
+			};
+
+			enum E_TYPE_FLAGS : uint32_t
+			{
+				MARKED_WITH_ATTRIBUTE    = 1 << 0,
+				HAS_PARENT               = 1 << 1,
+				HAS_TEMPLATE_PARENT      = 1 << 2, ///< The parent is a template class
+				FORWARD_DECLARATION      = 1 << 3,
+				STRONGLY_TYPED           = 1 << 4,
+				INTROSPECTABLE           = 1 << 5,
+				FINAL                    = 1 << 6,
+				STRUCT                   = 1 << 7,
+				UNION                    = 1 << 8,
+				TEMPLATE                 = 1 << 9,
+			};
+
+			struct TTypeRecord
+			{
+				TStringRef mId;
+				TStringRef mMangledId;
+				TStringRef mSectionId;
+
+				uint32_t   mFlags;
+
+				uint8_t    mAccessModifier;
+				uint8_t    mParentAccessModifier;
+				uint8_t    mSerializationFlags;
+				uint8_t    mPadding;
+
+				bool HasFlag(E_TYPE_FLAGS flag) const { return (mFlags & flag) == flag; }
+			};
+
+			struct TEnumRecord
+			{
+				TTypeRecord mType;
+				TStringRef  mUnderlyingType;
+				TArrayRef   mEnumerators; ///< The offset is an index of the first enumerator
+			};
+
+			struct TBaseClassRecord
+			{
+				TStringRef mFullName;
+				uint8_t    mAccessSpecifier;
+				uint8_t    mIsVirtualInherited;
+				uint16_t   mPadding;
+			};
+
+			struct TFieldRecord
+			{
+				TStringRef mName;
+				TStringRef mOriginalName;
+				uint32_t   mIsSerializable;
+			};
+
+			struct TClassRecord
+			{
+				TTypeRecord mType;
+				TArrayRef   mBaseClasses; ///< The offset is an index of the first base class
+				TArrayRef   mFields;      ///< The offset is an index of the first field
+			};
+
+			template <typename T>
+			struct TRecordsRange
+			{
+				const T* mpBegin = nullptr;
+				const T* mpEnd = nullptr;
+
+				const T* begin() const { return mpBegin; }
+				const T* end() const { return mpEnd; }
+
+				size_t size() const { return static_cast<size_t>(mpEnd - mpBegin); }
+
+				const T& operator[] (size_t index) const { return mpBegin[index]; }
+			};
+		public:
+			/*!
+				\brief The method serializes enums and classes of the table into the view's format
+			*/
+
+			static std::string Build(const SymTable& symTable);
+
+			/*!
+				\brief The method checks the header and bounds of all arrays. The view doesn't own the data, so it should stay
+				valid while the view is used. False is returned for data of another format or version
+			*/
+
+			bool Init(std::string_view data);
+
+			bool IsValid() const { return !mData.empty(); }
+
+			std::string_view GetString(const TStringRef& ref) const;
+			std::string_view GetSourceFilename() const;
+
+			TRecordsRange<TEnumRecord> GetEnums() const;
+			TRecordsRange<TClassRecord> GetClasses() const;
+
+			TRecordsRange<TStringRef> GetEnumerators(const TEnumRecord& enumRecord) const;
+			TRecordsRange<TBaseClassRecord> GetBaseClasses(const TClassRecord& classRecord) const;
+			TRecordsRange<TFieldRecord> GetFields(const TClassRecord& classRecord) const;
+
+			/*!
+				\brief The methods create a type from the record within the given table. A parent of the type isn't restored,
+				the record keeps all data of it that's needed
+			*/
+
+			TEnumType* CreateEnumType(const TEnumRecord& enumRecord, SymTable& symTable) const;
+			TClassType* CreateClassType(const TClassRecord& classRecord, SymTable& symTable) const;
+		private:
+			static constexpr uint32_t mMagic = 0x56544454; ///< TDTV
+			static constexpr uint32_t mFormatVersion = 1;
+
+			struct THeader
+			{
+				uint32_t   mMagic;
+				uint32_t   mVersion;
+				uint32_t   mSize;
+
+				TStringRef mSourceFilename;
+
+				TArrayRef  mEnums;
+				TArrayRef  mClasses;
+				TArrayRef  mEnumerators;
+				TArrayRef  mBaseClasses;
+				TArrayRef  mFields;
+				TArrayRef  mStrings; ///< The count is a size of the table in bytes
+			};
+		private:
+			template <typename T>
+			TRecordsRange<T> _getRecords(const TArrayRef& arrayRef) const;
+
+			template <typename T>
+			TRecordsRange<T> _getSubrange(const TArrayRef& arrayRef, const TArrayRef& subrangeRef) const;
+
+			void _fillType(const TTypeRecord& record, TType& type) const;
+		private:
+			std::string_view mData;
+
+			const THeader*   mpHeader = nullptr;
+	};
+
+
+	/*!
+		struct TSymTableSource
+
+		\brief The type represents symbols of a single header for the code generator. It's either a table that has been built by
+		the parser, or a view of a cached one. In the latter case types are created lazily only for records that pass extractors
+	*/
+
+	struct TSymTableSource
+	{
+		std::unique_ptr<SymTable>     mpSymTable;
+
+		SymTableView                  mView;
+		std::unique_ptr<IInputStream> mpViewStorage; ///< Keeps a mapped cache file alive while the view is used, null for views over the pack
+	};
+}
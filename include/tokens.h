@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <tuple>
 #include <string>
+#include <string_view>
 
 
 namespace TDEngine2
@@ -80,6 +81,8 @@ namespace TDEngine2
 		TT_SERIALIZE_MARKED_FIELDS_ONLY_FLAG,
 
 		TT_NUMBER,
+		TT_STRING_LITERAL,
+		TT_CHAR_LITERAL,
 		TT_UNKNOWN,
 	};
 
@@ -89,14 +92,85 @@ namespace TDEngine2
 		using TCursorPos = std::tuple<uint32_t, uint32_t>;
 
 		TToken() = default;
-		TToken(E_TOKEN_TYPE type, const std::string& value = "", const TCursorPos & pos = {0, 0});
+		TToken(E_TOKEN_TYPE type, std::string_view value = std::string_view(), uint32_t offset = 0);
 
-		E_TOKEN_TYPE mType = E_TOKEN_TYPE::TT_EOF;
-		TCursorPos   mPos = { 0, 0 };
-		std::string  mValue = "";
-		bool         mIsValid = false;
+		E_TOKEN_TYPE     mType = E_TOKEN_TYPE::TT_EOF;
+		uint32_t         mOffset = 0; // \note Byte offset of the token's beginning, use Lexer::GetCursorPosition to get its line and column
+		std::string_view mValue; // \note Points into the lexer's source buffer, so a token can't outlive its lexer
+		bool             mIsValid = false;
 	};
 
 
+	struct TReservedKeywordInfo
+	{
+		std::string_view mValue;
+		E_TOKEN_TYPE     mType;
+	};
+
+
+	inline constexpr TReservedKeywordInfo ReservedKeywordsTable[]
+	{
+		{ "namespace", E_TOKEN_TYPE::TT_NAMESPACE },
+		{ "enum", E_TOKEN_TYPE::TT_ENUM },
+		{ "class", E_TOKEN_TYPE::TT_CLASS },
+		{ "struct", E_TOKEN_TYPE::TT_STRUCT },
+		{ "union", E_TOKEN_TYPE::TT_UNION },
+		{ "public", E_TOKEN_TYPE::TT_PUBLIC },
+		{ "protected", E_TOKEN_TYPE::TT_PROTECTED },
+		{ "private", E_TOKEN_TYPE::TT_PRIVATE },
+		{ "virtual", E_TOKEN_TYPE::TT_VIRTUAL },
+		{ "override", E_TOKEN_TYPE::TT_OVERRIDE },
+		{ "final", E_TOKEN_TYPE::TT_FINAL },
+		{ "template", E_TOKEN_TYPE::TT_TEMPLATE },
+		{ "ENUM_META", E_TOKEN_TYPE::TT_ENUM_META_ATTRIBUTE },
+		{ "CLASS_META", E_TOKEN_TYPE::TT_CLASS_META_ATTRIBUTE },
+		{ "FIELD_META", E_TOKEN_TYPE::TT_FIELD_META_ATTRIBUTE },
+		{ "INTERFACE_META", E_TOKEN_TYPE::TT_INTERFACE_META_ATTRIBUTE },
+		{ "BEGIN_IGNORE_META_SECTION", E_TOKEN_TYPE::TT_BEGIN_IGNORE_SECTION },
+		{ "END_IGNORE_META_SECTION", E_TOKEN_TYPE::TT_END_IGNORE_SECTION },
+		{ "SECTION", E_TOKEN_TYPE::TT_SECTION_TAG_KEY },
+		{ "section", E_TOKEN_TYPE::TT_SECTION_TAG_KEY },
+		{ "NAME", E_TOKEN_TYPE::TT_NAME_TAG_KEY },
+		{ "name", E_TOKEN_TYPE::TT_NAME_TAG_KEY },
+		{ "FLAGS", E_TOKEN_TYPE::TT_FLAGS_TAG_KEY },
+		{ "flags", E_TOKEN_TYPE::TT_FLAGS_TAG_KEY },
+		{ "SERIALIZE_ALL_FIELDS", E_TOKEN_TYPE::TT_SERIALIZE_ALL_FIELDS_FLAG },
+		{ "SERIALIZE_MARKED_ONLY_FIELDS", E_TOKEN_TYPE::TT_SERIALIZE_MARKED_FIELDS_ONLY_FLAG },
+		{ "char", E_TOKEN_TYPE::TT_CHAR },
+		{ "char16_t", E_TOKEN_TYPE::TT_CHAR16_T },
+		{ "char32_t", E_TOKEN_TYPE::TT_CHAR32_T },
+		{ "wchar_t", E_TOKEN_TYPE::TT_WCHAR_T },
+		{ "bool", E_TOKEN_TYPE::TT_BOOL },
+		{ "short", E_TOKEN_TYPE::TT_SHORT },
+		{ "int", E_TOKEN_TYPE::TT_INT },
+		{ "long", E_TOKEN_TYPE::TT_LONG },
+		{ "signed", E_TOKEN_TYPE::TT_SIGNED },
+		{ "unsigned", E_TOKEN_TYPE::TT_UNSIGNED },
+		{ "float", E_TOKEN_TYPE::TT_FLOAT },
+		{ "double", E_TOKEN_TYPE::TT_DOUBLE },
+		{ "void", E_TOKEN_TYPE::TT_VOID },
+		{ "auto", E_TOKEN_TYPE::TT_AUTO },
+		{ "decltype", E_TOKEN_TYPE::TT_DECLTYPE },
+		{ "typedef", E_TOKEN_TYPE::TT_TYPEDEF },
+		{ "using", E_TOKEN_TYPE::TT_USING },
+		{ "static", E_TOKEN_TYPE::TT_STATIC },
+		{ "inline", E_TOKEN_TYPE::TT_INLINE },
+	};
+
+
+	/*!
+		\brief The function returns a type of a reserved keyword or TT_IDENTIFIER if the value isn't reserved.
+		The lookup uses a perfect hash table that's built at compile time, so there are neither allocations nor probing
+	*/
+
+	E_TOKEN_TYPE GetKeywordTokenType(std::string_view value);
+
+	/*!
+		\brief The function returns a type of a punctuator that consists of one or two characters, TT_UNKNOWN otherwise
+	*/
+
+	E_TOKEN_TYPE GetPunctuatorTokenType(std::string_view value);
+
+
 	std::string TokenTypeToString(const E_TOKEN_TYPE& type);
 }
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "../include/arena.h"
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+
+namespace TDEngine2
+{
+	MemoryArena::MemoryArena(size_t blockSize):
+		mBlockSize(blockSize)
+	{
+		assert(blockSize);
+	}
+
+	MemoryArena::~MemoryArena()
+	{
+		_destroyObjects();
+	}
+
+	void* MemoryArena::Allocate(size_t size, size_t alignment)
+	{
+		assert(alignment && !(alignment & (alignment - 1)));
+
+		if (!mBlocks.empty())
+		{
+			TBlock& currBlock = mBlocks.back();
+
+			const uintptr_t blockStart = reinterpret_cast<uintptr_t>(currBlock.mpData.get());
+			const uintptr_t alignedPos = (blockStart + mCurrBlockOffset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+			const size_t    nextOffset = static_cast<size_t>(alignedPos - blockStart) + size;
+
+			if (nextOffset <= currBlock.mSize)
+			{
+				mUsedSize += nextOffset - mCurrBlockOffset;
+				mCurrBlockOffset = nextOffset;
+
+				return reinterpret_cast<void*>(alignedPos);
+			}
+		}
+
+		/// \note Allocate a new block, a large object gets its own block of appropriate size
+		const size_t blockSize = (std::max)(mBlockSize, size + alignment);
+
+		mBlocks.push_back({ std::make_unique<uint8_t[]>(blockSize), blockSize });
+		mCurrBlockOffset = 0;
+
+		return Allocate(size, alignment);
+	}
+
+	std::string_view MemoryArena::CreateString(std::string_view str)
+	{
+		if (str.empty())
+		{
+			return std::string_view();
+		}
+
+		char* pBuffer = static_cast<char*>(Allocate(str.size(), 1));
+		std::memcpy(pBuffer, str.data(), str.size());
+
+		return std::string_view(pBuffer, str.size());
+	}
+
+	void MemoryArena::Reset()
+	{
+		_destroyObjects();
+
+		if (mBlocks.size() > 1)
+		{
+			mBlocks.erase(mBlocks.begin() + 1, mBlocks.end());
+		}
+
+		mCurrBlockOffset = 0;
+		mUsedSize = 0;
+	}
+
+	size_t MemoryArena::GetUsedSize() const
+	{
+		return mUsedSize;
+	}
+
+	void MemoryArena::_destroyObjects()
+	{
+		for (auto it = mDestructors.rbegin(); it != mDestructors.rend(); ++it)
+		{
+			it->mpDestructor(it->mpObject);
+		}
+
+		mDestructors.clear();
+	}
+}
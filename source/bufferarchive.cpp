@@ -0,0 +1,156 @@
+#include "../include/bufferarchive.h"
+#include <fstream>
+#include <cstring>
+
+
+namespace TDEngine2
+{
+	static constexpr uint32_t MaxVarintSize = 10; ///< ceil(64 / 7)
+
+
+	BufferWriterArchive::BufferWriterArchive(size_t capacity)
+	{
+		mBuffer.reserve(capacity);
+	}
+
+	BufferWriterArchive& BufferWriterArchive::operator<< (std::string_view value)
+	{
+		WriteVarint(value.size());
+		mBuffer.append(value);
+
+		return *this;
+	}
+
+	BufferWriterArchive& BufferWriterArchive::operator<< (const std::string& value)
+	{
+		return *this << std::string_view(value);
+	}
+
+	BufferWriterArchive& BufferWriterArchive::operator<< (const char* pValue)
+	{
+		return *this << std::string_view(pValue ? pValue : "");
+	}
+
+	void BufferWriterArchive::WriteVarint(uint64_t value)
+	{
+		char bytes[MaxVarintSize];
+		uint32_t size = 0;
+
+		while (value >= 0x80)
+		{
+			bytes[size++] = static_cast<char>((value & 0x7F) | 0x80);
+			value >>= 7;
+		}
+
+		bytes[size++] = static_cast<char>(value);
+
+		mBuffer.append(bytes, size);
+	}
+
+	void BufferWriterArchive::WriteBytes(const void* pData, size_t size)
+	{
+		mBuffer.append(static_cast<const char*>(pData), size);
+	}
+
+	bool BufferWriterArchive::SaveToFile(const std::string& filename) const
+	{
+		std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+		file.close();
+
+		return !file.fail();
+	}
+
+	void BufferWriterArchive::Reset()
+	{
+		mBuffer.clear();
+	}
+
+	const std::string& BufferWriterArchive::GetBuffer() const
+	{
+		return mBuffer;
+	}
+
+
+	BufferReaderArchive::BufferReaderArchive(std::string_view data):
+		mData(data)
+	{
+	}
+
+	BufferReaderArchive& BufferReaderArchive::operator>> (std::string& value)
+	{
+		value.clear();
+
+		uint64_t size = 0;
+
+		if (!ReadVarint(size) || size > GetRemainingSize())
+		{
+			mHasFailed = true;
+			return *this;
+		}
+
+		value.assign(mData.data() + mPosition, static_cast<size_t>(size));
+		mPosition += static_cast<size_t>(size);
+
+		return *this;
+	}
+
+	bool BufferReaderArchive::ReadVarint(uint64_t& value)
+	{
+		value = 0;
+
+		if (mHasFailed)
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < MaxVarintSize && mPosition < mData.size(); ++i)
+		{
+			const uint8_t currByte = static_cast<uint8_t>(mData[mPosition++]);
+
+			value |= static_cast<uint64_t>(currByte & 0x7F) << (7 * i);
+
+			if (!(currByte & 0x80))
+			{
+				return true;
+			}
+		}
+
+		/// \note The data has ended or the varint is longer than any 64 bits value
+		value = 0;
+		mHasFailed = true;
+
+		return false;
+	}
+
+	bool BufferReaderArchive::ReadBytes(void* pData, size_t size)
+	{
+		if (mHasFailed || size > GetRemainingSize())
+		{
+			std::memset(pData, 0, size);
+			mHasFailed = true;
+
+			return false;
+		}
+
+		std::memcpy(pData, mData.data() + mPosition, size);
+		mPosition += size;
+
+		return true;
+	}
+
+	bool BufferReaderArchive::HasFailed() const
+	{
+		return mHasFailed;
+	}
+
+	size_t BufferReaderArchive::GetRemainingSize() const
+	{
+		return mData.size() - mPosition;
+	}
+}
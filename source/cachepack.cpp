@@ -0,0 +1,195 @@
+#include "../include/cachepack.h"
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+
+namespace TDEngine2
+{
+	CachePack::~CachePack()
+	{
+		_close();
+	}
+
+	bool CachePack::Open(const std::string& filename)
+	{
+		_close();
+
+		mpMappedFile = std::make_unique<MemoryMappedInputStream>(filename);
+
+		if (!mpMappedFile->Open())
+		{
+			_close();
+			return false;
+		}
+
+		const std::string_view contents = mpMappedFile->GetContents();
+
+		THeader header;
+
+		if (contents.size() < sizeof(THeader))
+		{
+			_close();
+			return false;
+		}
+
+		std::memcpy(&header, contents.data(), sizeof(THeader));
+
+		if (header.mMagic != mMagic || header.mVersion != mFormatVersion ||
+			header.mEntriesCount > (contents.size() - sizeof(THeader)) / sizeof(TEntry))
+		{
+			_close();
+			return false;
+		}
+
+		mpEntries = reinterpret_cast<const TEntry*>(contents.data() + sizeof(THeader)); // \note The mapping is page aligned, entries go right after the header
+		mEntriesCount = header.mEntriesCount;
+
+		for (uint64_t i = 0; i < mEntriesCount; ++i)
+		{
+			if (mpEntries[i].mOffset > contents.size() || mpEntries[i].mSize > contents.size() - mpEntries[i].mOffset)
+			{
+				_close();
+				return false;
+			}
+		}
+
+		mUsedEntries.assign(static_cast<size_t>(mEntriesCount), false);
+
+		return true;
+	}
+
+	std::string_view CachePack::Find(const THash128& key)
+	{
+		const TEntry* pEntriesEnd = mpEntries + mEntriesCount;
+
+		const TEntry* pEntry = std::lower_bound(mpEntries, pEntriesEnd, key, [](const TEntry& entry, const THash128& key)
+		{
+			return (entry.mKeyHigh != key.mHigh) ? (entry.mKeyHigh < key.mHigh) : (entry.mKeyLow < key.mLow);
+		});
+
+		if (pEntry == pEntriesEnd || pEntry->mKeyLow != key.mLow || pEntry->mKeyHigh != key.mHigh)
+		{
+			return std::string_view();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mUsedEntries[pEntry - mpEntries] = true;
+		}
+
+		return mpMappedFile->GetContents().substr(static_cast<size_t>(pEntry->mOffset), static_cast<size_t>(pEntry->mSize));
+	}
+
+	void CachePack::Add(const THash128& key, std::string&& blob)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mNewBlobs.push_back({ key, std::move(blob) });
+	}
+
+	bool CachePack::Save(const std::string& filename)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		const bool hasUnusedEntries = std::find(mUsedEntries.cbegin(), mUsedEntries.cend(), false) != mUsedEntries.cend();
+
+		if (mNewBlobs.empty() && !hasUnusedEntries && mpMappedFile)
+		{
+			return true; // \note Nothing has been changed since the pack was written
+		}
+
+		/// \note Collect blobs that should be written, new ones replace old blobs with the same keys
+		std::vector<std::pair<TEntry, std::string_view>> blobs;
+
+		for (auto&& currBlob : mNewBlobs)
+		{
+			blobs.push_back({ { currBlob.mKey.mLow, currBlob.mKey.mHigh, 0, currBlob.mData.size() }, currBlob.mData });
+		}
+
+		for (uint64_t i = 0; i < mEntriesCount; ++i)
+		{
+			if (mUsedEntries[i])
+			{
+				const TEntry& currEntry = mpEntries[i];
+				blobs.push_back({ currEntry, mpMappedFile->GetContents().substr(static_cast<size_t>(currEntry.mOffset), static_cast<size_t>(currEntry.mSize)) });
+			}
+		}
+
+		std::stable_sort(blobs.begin(), blobs.end(), [](auto&& left, auto&& right)
+		{
+			return (left.first.mKeyHigh != right.first.mKeyHigh) ? (left.first.mKeyHigh < right.first.mKeyHigh) : (left.first.mKeyLow < right.first.mKeyLow);
+		});
+
+		blobs.erase(std::unique(blobs.begin(), blobs.end(), [](auto&& left, auto&& right)
+		{
+			return left.first.mKeyLow == right.first.mKeyLow && left.first.mKeyHigh == right.first.mKeyHigh;
+		}), blobs.end());
+
+		const THeader header { mMagic, mFormatVersion, blobs.size() };
+
+		uint64_t offset = sizeof(THeader) + blobs.size() * sizeof(TEntry);
+
+		for (auto&& currBlob : blobs)
+		{
+			currBlob.first.mOffset = offset;
+			offset += (currBlob.first.mSize + mBlobAlignment - 1) & ~(mBlobAlignment - 1); // \note Blobs are aligned, so they could be accessed in place
+		}
+
+		const std::string tempFilename = filename + ".tmp";
+
+		{
+			std::ofstream packFile(tempFilename, std::ios::binary | std::ios::trunc);
+			if (!packFile.is_open())
+			{
+				return false;
+			}
+
+			packFile.write(reinterpret_cast<const char*>(&header), sizeof(THeader));
+
+			for (auto&& currBlob : blobs)
+			{
+				packFile.write(reinterpret_cast<const char*>(&currBlob.first), sizeof(TEntry));
+			}
+
+			static const char padding[mBlobAlignment] {};
+
+			for (auto&& currBlob : blobs)
+			{
+				packFile.write(currBlob.second.data(), static_cast<std::streamsize>(currBlob.second.size()));
+				packFile.write(padding, static_cast<std::streamsize>((mBlobAlignment - currBlob.second.size() % mBlobAlignment) % mBlobAlignment));
+			}
+
+			if (!packFile.good())
+			{
+				packFile.close();
+				std::remove(tempFilename.c_str());
+
+				return false;
+			}
+		}
+
+		mNewBlobs.clear();
+		_close(); // \note Release the mapping, views of old blobs aren't needed anymore
+
+#if defined(_WIN32)
+		std::remove(filename.c_str()); // \note rename doesn't replace existing files on Windows
+#endif
+
+		return std::rename(tempFilename.c_str(), filename.c_str()) == 0;
+	}
+
+	void CachePack::_close()
+	{
+		if (mpMappedFile)
+		{
+			mpMappedFile->Close();
+			mpMappedFile = nullptr;
+		}
+
+		mpEntries = nullptr;
+		mEntriesCount = 0;
+
+		mUsedEntries.clear();
+	}
+}
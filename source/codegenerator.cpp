@@ -1,12 +1,15 @@
 #include "../include/codegenerator.h"
 #include "../include/common.h"
 #include "../deps/Wrench/source/stringUtils.hpp"
+#include "../include/jobmanager.h"
+#include "../include/codetemplate.h"
 #include <set>
+#include <algorithm>
 
 
 namespace TDEngine2
 {
-	static const std::string mEnumTraitTemplateSpecializationHeaderPattern = R"(
+	static const CodeTemplate mEnumTraitTemplateSpecializationHeaderPattern { R"(
 template <>
 struct EnumTrait<{0}>
 {
@@ -54,10 +57,10 @@ template <> struct HasMetaData<{0}> : std::true_type { };
 #ifdef META_IMPLEMENTATION
 constexpr std::array<EnumFieldInfo<{0}>, {2}> EnumTrait<{0}>::fields;
 #endif
-)";
+)" };
 
 
-	const std::string CodeGenerator::mClassTraitTemplateSpecializationHeaderPattern = R"(
+	const CodeTemplate CodeGenerator::mClassTraitTemplateSpecializationHeaderPattern { R"(
 template <>
 struct ClassTrait<{0}>
 {
@@ -93,10 +96,13 @@ template<> struct Type<TYPEID({8})> { using Value = {0}; }; /// {0}
 #endif
 
 
-)";
+)" };
 
-	const std::string CodeGenerator::mEnumeratorFieldPattern = "EnumFieldInfo<{0}> { {1}, \"{2}\" }";
-	const std::string CodeGenerator::mClassTypeFieldPattern = "ClassFieldInfo<{0}, decltype({0}::{2})> { \"{1}\", &{0}::{2}, {3} }";
+	const CodeTemplate CodeGenerator::mEnumeratorFieldPattern { "EnumFieldInfo<{0}> { {1}, \"{2}\" }" };
+	const CodeTemplate CodeGenerator::mClassTypeFieldPattern { "ClassFieldInfo<{0}, decltype({0}::{2})> { \"{1}\", &{0}::{2}, {3} }" };
+
+	const CodeTemplate CodeGenerator::mSectionHeaderPattern { "\n#ifdef META_EXPORT_{0}_SECTION\n" };
+	const CodeTemplate CodeGenerator::mInclusionPattern { "\t#include \"{0}\"\n" };
 
 	const std::string EnumValueToStringConverterPattern = "\t\tif ({0} == value) { return \"{1}\"; }\n";
 
@@ -117,7 +123,7 @@ template<> struct Type<TYPEID({8})> { using Value = {0}; }; /// {0}
 	}
 
 	bool CodeGenerator::Init(const TOutputStreamFactoryFunctor& outputStreamsFactory, const std::string& outputFilename, const E_EMIT_FLAGS& flags,
-							const std::vector<std::regex>& excludeTypenamePatterns, bool isTaggedOnlyModeEnabled)
+							const std::vector<std::regex>& excludeTypenamePatterns, bool isTaggedOnlyModeEnabled, uint32_t threadsCount)
 	{
 		if (!outputStreamsFactory)
 		{
@@ -135,6 +141,8 @@ template<> struct Type<TYPEID({8})> { using Value = {0}; }; /// {0}
 
 		mIsTaggedOnlyMode = isTaggedOnlyModeEnabled;
 
+		mThreadsCount = (std::max)(1u, threadsCount);
+
 		if (!mpHeaderOutputStream)
 		{
 			return false;
@@ -150,28 +158,52 @@ template<> struct Type<TYPEID({8})> { using Value = {0}; }; /// {0}
 
 	bool CodeGenerator::Generate(TSymbolTablesArray&& symbolTablesPerFile)
 	{
-		EnumsMetaExtractor enumsExtractor(mEmitFlags);
-		ClassMetaExtractor classesExtractor(mEmitFlags);
+		MetaTypesMergeTable<TEnumType> enumsTable;
+		MetaTypesMergeTable<TClassType> classesTable;
 
-		// \note Collect data from symbol tables
-		for (auto&& pCurrSymbolTable : symbolTablesPerFile)
+		auto extractTypes = [this, &symbolTablesPerFile, &enumsTable, &classesTable](uint32_t index)
 		{
-			if (!pCurrSymbolTable)
+			TSymTableSource& source = symbolTablesPerFile[index];
+
+			EnumsMetaExtractor enumsExtractor(mEmitFlags);
+			ClassMetaExtractor classesExtractor(mEmitFlags);
+
+			if (const SymTable* pSymbolTable = source.mpSymTable.get())
 			{
-				continue;
+				enumsExtractor.Extract(*pSymbolTable);
+				classesExtractor.Extract(*pSymbolTable);
 			}
+			else if (source.mView.IsValid())
+			{
+				/// \note The table owns only types that have passed the extractors
+				source.mpSymTable = std::make_unique<SymTable>();
+				source.mpSymTable->SetSourceFilename(std::string(source.mView.GetSourceFilename()));
 
-			pCurrSymbolTable->Visit(enumsExtractor);
-			pCurrSymbolTable->Visit(classesExtractor);
-		}
+				enumsExtractor.Extract(source.mView, *source.mpSymTable);
+				classesExtractor.Extract(source.mView, *source.mpSymTable);
+			}
+			else
+			{
+				return;
+			}
+
+			enumsTable.Merge(enumsExtractor, index);
+			classesTable.Merge(classesExtractor, index);
+		};
+
+		// \note Collect data from symbol tables
+		_executeJobs(static_cast<uint32_t>(symbolTablesPerFile.size()), extractTypes);
+
+		const auto enums = enumsTable.GetTypes();
+		const auto classes = classesTable.GetTypes();
 
-		std::string dependenciesInclusionsStr = WriteInclusions(enumsExtractor);
-		dependenciesInclusionsStr.append(WriteInclusions(classesExtractor));
+		std::string dependenciesInclusionsStr = WriteInclusions<TEnumType>(enums);
+		dependenciesInclusionsStr.append(WriteInclusions<TClassType>(classes));
 
 		_writeHeaderPrelude(dependenciesInclusionsStr);
 
-		const bool enumsWriteResult   = WriteMetaData("\n/*\n\tEnum's meta\n*/\n\n", enumsExtractor);
-		const bool classesWriteResult = WriteMetaData("\n/*\n\tClasses's meta\n*/\n\n", classesExtractor);
+		const bool enumsWriteResult   = WriteMetaData<TEnumType>("\n/*\n\tEnum's meta\n*/\n\n", enums);
+		const bool classesWriteResult = WriteMetaData<TClassType>("\n/*\n\tClasses's meta\n*/\n\n", classes);
 
 		return enumsWriteResult && classesWriteResult;
 	}
@@ -182,15 +214,42 @@ template<> struct Type<TYPEID({8})> { using Value = {0}; }; /// {0}
 	}
 
 	void CodeGenerator::VisitEnumType(const TEnumType& type)
+	{
+		std::string output;
+		_writeTrait(type, output);
+
+		mpHeaderOutputStream->WriteString(output);
+	}
+
+	void CodeGenerator::VisitNamespaceType(const TNamespaceType& type)
+	{
+
+	}
+
+	void CodeGenerator::VisitClassType(const TClassType& type)
+	{
+		std::string output;
+		_writeTrait(type, output);
+
+		mpHeaderOutputStream->WriteString(output);
+	}
+
+	void CodeGenerator::_writeHeaderPrelude(const std::string& inclusionsPart)
+	{
+		mpHeaderOutputStream->WriteString("#pragma once\n\n");
+		mpHeaderOutputStream->WriteString(Wrench::StringUtils::Format(GeneratedHeaderPrelude, inclusionsPart));
+	}
+
+	void CodeGenerator::_writeTrait(const TEnumType& type, std::string& output) const
 	{
 		if (type.mIsForwardDeclaration ||
-			_shouldSkipGeneration(type.mId) || 
+			_shouldSkipGeneration(type.mId.ToString()) || 
 			(mIsTaggedOnlyMode && !type.mIsMarkedWithAttribute)) // \note skip forward declarations to prevent duplicates of traits of the same type
 		{
 			return;
 		}
 
-		std::string fullEnumName = "::" + Wrench::StringUtils::ReplaceAll(type.mMangledId, "@", "::");
+		std::string fullEnumName = "::" + Wrench::StringUtils::ReplaceAll(type.mMangledId.ToString(), "@", "::");
 
 		size_t enumeratorsCount = type.mEnumerators.size();
 
@@ -202,40 +261,34 @@ template<> struct Type<TYPEID({8})> { using Value = {0}; }; /// {0}
 		{
 			auto&& currEnumerator = enumerators[i];
 
-			fieldsStr
-				.append(Wrench::StringUtils::Format(mEnumeratorFieldPattern, fullEnumName, fullEnumName + "::" + currEnumerator, currEnumerator))
-				.append(i + 1 < enumeratorsCount ? "," : "").append("\n\t\t");
+			mEnumeratorFieldPattern.Emit(fieldsStr, { fullEnumName, fullEnumName + "::" + currEnumerator, currEnumerator });
+
+			fieldsStr.append(i + 1 < enumeratorsCount ? "," : "").append("\n\t\t");
 		}
 
 		std::string sectionIdentifier = type.mAttributes.mSectionId.empty() ? "ALL" : type.mAttributes.mSectionId; /// \todo replace DEFAULT with configurable constant
 		std::transform(sectionIdentifier.begin(), sectionIdentifier.end(), sectionIdentifier.begin(), ::toupper);	/// \note Convert to upper case
 
-		mpHeaderOutputStream->WriteString(Wrench::StringUtils::Format("\n#ifdef META_EXPORT_{0}_SECTION\n", sectionIdentifier));
+		mSectionHeaderPattern.Emit(output, { sectionIdentifier });
 
-		mpHeaderOutputStream->WriteString(Wrench::StringUtils::Format(mEnumTraitTemplateSpecializationHeaderPattern,
-															  fullEnumName,
-															  (type.mIsStronglyTyped ? mTrueConstant : mFalseConstant),
-															  enumeratorsCount, fieldsStr));
+		mEnumTraitTemplateSpecializationHeaderPattern.Emit(output, { fullEnumName,
+																	 (type.mIsStronglyTyped ? mTrueConstant : mFalseConstant),
+																	 std::to_string(enumeratorsCount), fieldsStr });
 
-		mpHeaderOutputStream->WriteString("\n#endif\n");
+		output.append("\n#endif\n");
 	}
 
-	void CodeGenerator::VisitNamespaceType(const TNamespaceType& type)
-	{
-
-	}
-
-	void CodeGenerator::VisitClassType(const TClassType& type)
+	void CodeGenerator::_writeTrait(const TClassType& type, std::string& output) const
 	{
 		if (type.mIsForwardDeclaration ||
 			type.mIsTemplate ||
-			_shouldSkipGeneration(type.mId) ||
+			_shouldSkipGeneration(type.mId.ToString()) ||
 			(mIsTaggedOnlyMode && !type.mIsMarkedWithAttribute)) // \note skip forward declarations to prevent duplicates of traits of the same type
 		{
 			return;
 		}
 
-		std::string fullClassIdentifier = "::" + Wrench::StringUtils::ReplaceAll(type.mMangledId, "@", "::");
+		std::string fullClassIdentifier = "::" + Wrench::StringUtils::ReplaceAll(type.mMangledId.ToString(), "@", "::");
 
 		auto&& parentClasses = _getParentClasses(type);
 
@@ -245,35 +298,49 @@ template<> struct Type<TYPEID({8})> { using Value = {0}; }; /// {0}
 
 		for (size_t i = 0; i < fieldsCount; ++i)
 		{
-			const std::string& identifier = type.mFields[i].mName.empty() ? type.mFields[i].mOriginalName : type.mFields[i].mName;
+			const std::string originalName = type.mFields[i].mOriginalName.ToString();
+			const std::string& identifier = type.mFields[i].mName.empty() ? originalName : type.mFields[i].mName;
+
+			mClassTypeFieldPattern.Emit(fieldsStr, { fullClassIdentifier, identifier, originalName, type.mFields[i].mIsSerializable ? mTrueConstant : mFalseConstant });
 
-			fieldsStr
-				.append(Wrench::StringUtils::Format(mClassTypeFieldPattern, fullClassIdentifier, identifier, type.mFields[i].mOriginalName, type.mFields[i].mIsSerializable ? "true" : "false"))
-				.append(i + 1 < fieldsCount ? "," : Wrench::StringUtils::GetEmptyStr()).append("\n\t\t");
+			fieldsStr.append(i + 1 < fieldsCount ? "," : Wrench::StringUtils::GetEmptyStr()).append("\n\t\t");
 		}
 
 		std::string sectionIdentifier = type.mAttributes.mSectionId.empty() ? "ALL" : type.mAttributes.mSectionId; /// \todo replace DEFAULT with configurable constant
 		std::transform(sectionIdentifier.begin(), sectionIdentifier.end(), sectionIdentifier.begin(), ::toupper);	/// \note Convert to upper case
 
-		mpHeaderOutputStream->WriteString(Wrench::StringUtils::Format("\n#ifdef META_EXPORT_{0}_SECTION\n", sectionIdentifier));
+		mSectionHeaderPattern.Emit(output, { sectionIdentifier });
 
-		mpHeaderOutputStream->WriteString(Wrench::StringUtils::Format(mClassTraitTemplateSpecializationHeaderPattern,
-															  fullClassIdentifier,
-															  mFalseConstant,
-															  mFalseConstant,
-															  0, 
-															  parentClasses.size(), 
-															  "{}",
-															  _vectorToString(parentClasses),
-			                                                fieldsStr, type.mId));
+		mClassTraitTemplateSpecializationHeaderPattern.Emit(output, { fullClassIdentifier,
+																	  mFalseConstant,
+																	  mFalseConstant,
+																	  "0",
+																	  std::to_string(parentClasses.size()),
+																	  "{}",
+																	  _vectorToString(parentClasses),
+																	  fieldsStr, type.mId.GetString() });
 
-		mpHeaderOutputStream->WriteString("\n#endif\n");
+		output.append("\n#endif\n");
 	}
 
-	void CodeGenerator::_writeHeaderPrelude(const std::string& inclusionsPart)
+	void CodeGenerator::_executeJobs(uint32_t jobsCount, const std::function<void(uint32_t)>& job) const
 	{
-		mpHeaderOutputStream->WriteString("#pragma once\n\n");
-		mpHeaderOutputStream->WriteString(Wrench::StringUtils::Format(GeneratedHeaderPrelude, inclusionsPart));
+		if (mThreadsCount < 2 || jobsCount < 2)
+		{
+			for (uint32_t i = 0; i < jobsCount; ++i)
+			{
+				job(i);
+			}
+
+			return;
+		}
+
+		JobManager jobManager((std::min)(mThreadsCount, jobsCount)); // \note Wait for all jobs at the end of the scope
+
+		for (uint32_t i = 0; i < jobsCount; ++i)
+		{
+			jobManager.SubmitJob(std::function<void()>([&job, i] { job(i); }));
+		}
 	}
 
 	std::vector<std::string> CodeGenerator::_getParentClasses(const TClassType& classType)
@@ -282,7 +349,7 @@ template<> struct Type<TYPEID({8})> { using Value = {0}; }; /// {0}
 
 		for (auto&& currBaseClassInfo : classType.mBaseClasses)
 		{
-			parentClasses.push_back(Wrench::StringUtils::Format("TYPEID({0})", currBaseClassInfo.mFullName));
+			parentClasses.push_back(std::string("TYPEID(").append(currBaseClassInfo.mFullName.GetString()).append(")"));
 		}
 
 		return parentClasses;
@@ -0,0 +1,94 @@
+#include "../include/codetemplate.h"
+#include <cctype>
+
+
+namespace TDEngine2
+{
+	CodeTemplate::CodeTemplate(std::string_view pattern):
+		mPattern(pattern)
+	{
+		const uint32_t patternSize = static_cast<uint32_t>(mPattern.size());
+
+		uint32_t literalStart = 0;
+
+		auto appendLiteral = [this, &literalStart](uint32_t end)
+		{
+			if (end > literalStart)
+			{
+				mSegments.push_back({ literalStart, end - literalStart, mLiteralSegmentId });
+				mLiteralsSize += end - literalStart;
+			}
+		};
+
+		for (uint32_t i = 0; i < patternSize; ++i)
+		{
+			if (mPattern[i] != '{')
+			{
+				continue;
+			}
+
+			uint32_t pos = i + 1;
+			uint32_t argIndex = 0;
+
+			while (pos < patternSize && std::isdigit(static_cast<unsigned char>(mPattern[pos])))
+			{
+				argIndex = argIndex * 10 + static_cast<uint32_t>(mPattern[pos++] - '0');
+			}
+
+			if (pos == i + 1 || pos >= patternSize || mPattern[pos] != '}') // \note Not a placeholder, so it's a part of a literal
+			{
+				continue;
+			}
+
+			appendLiteral(i);
+			mSegments.push_back({ i, pos + 1 - i, argIndex });
+
+			literalStart = pos + 1;
+			i = pos;
+		}
+
+		appendLiteral(patternSize);
+	}
+
+	void CodeTemplate::Emit(std::string& output, std::initializer_list<std::string_view> args) const
+	{
+		const std::string_view* pArgs = args.begin();
+		const uint32_t argsCount = static_cast<uint32_t>(args.size());
+
+		size_t outputSize = output.size() + mLiteralsSize;
+
+		for (const TSegment& currSegment : mSegments)
+		{
+			if (currSegment.mArgIndex != mLiteralSegmentId)
+			{
+				outputSize += (currSegment.mArgIndex < argsCount) ? pArgs[currSegment.mArgIndex].size() : currSegment.mSize;
+			}
+		}
+
+		output.reserve(outputSize);
+
+		for (const TSegment& currSegment : mSegments)
+		{
+			if (currSegment.mArgIndex != mLiteralSegmentId && currSegment.mArgIndex < argsCount)
+			{
+				output.append(pArgs[currSegment.mArgIndex]);
+				continue;
+			}
+
+			output.append(mPattern, currSegment.mOffset, currSegment.mSize);
+		}
+	}
+
+	std::string CodeTemplate::ToString(std::initializer_list<std::string_view> args) const
+	{
+		std::string output;
+		Emit(output, args);
+
+		return output;
+	}
+
+	size_t CodeTemplate::GetLiteralsSize() const
+	{
+		return mLiteralsSize;
+	}
+}
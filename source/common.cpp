@@ -13,9 +13,8 @@
 #include "../include/symtable.h"
 #include "../deps/argparse/argparse.h"
 #include "../deps/PicoSHA2/picosha2.h"
-#include "../deps/archive/archive.h"
+#include "../include/bufferarchive.h"
 #include "../deps/Wrench/source/stringUtils.hpp"
-#include "../deps/Wrench/source/deferOperation.hpp"
 #include <iostream>
 #include <fstream>
 #include <array>
@@ -23,6 +22,8 @@
 #include <unordered_set>
 #include <string>
 #include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #include <experimental/filesystem>
 namespace fs = std::experimental::filesystem;
@@ -49,6 +50,7 @@ namespace TDEngine2
 		int taggedOnly = 0;
 		int suppressLogOutput = 0;
 		int forceMode = 0;
+		int packedCache = 0;
 		int emitFlags = 0;
 #ifdef _DEBUG
 		int debuggerMode = 0;
@@ -72,6 +74,7 @@ namespace TDEngine2
 			OPT_BOOLEAN('t', "tagged-only", &taggedOnly, "The flag enables a mode when only tagged with corresponding attributes types will be passed into output file"),
 			OPT_BOOLEAN('q', "quiet", &suppressLogOutput, "Enables suppresion of program's output"),
 			OPT_BOOLEAN('F', "force", &forceMode, "Enables force mode for the utility, all cached data will be ignored"),
+			OPT_BOOLEAN(0, "packed-cache", &packedCache, "Symbol tables of all headers are cached within a single memory-mapped file instead of a file per header"),
 #ifdef _DEBUG
 			OPT_BOOLEAN(0, "debugger", &debuggerMode, "Enables mode when the utility waits until debugger connected"),
 #endif
@@ -101,6 +104,7 @@ namespace TDEngine2
 		utilityOptions.mIsTaggedOnlyModeEnabled   = static_cast<bool>(taggedOnly);
 		utilityOptions.mIsLogOutputEnabled        = !static_cast<bool>(suppressLogOutput);
 		utilityOptions.mIsForceModeEnabled        = static_cast<bool>(forceMode);
+		utilityOptions.mIsPackedCacheEnabled      = static_cast<bool>(packedCache);
 #ifdef _DEBUG
 		utilityOptions.mIsWaitDebuggerModeEnabled = static_cast<bool>(debuggerMode);
 #endif
@@ -162,6 +166,8 @@ namespace TDEngine2
 			{
 				utilityOptions.mTypenamesPatternsToExclude.emplace_back(currPatternStr);
 			}
+
+			utilityOptions.mTypenamesPatternsToExcludeStr = pExcludedTypenamesStr;
 		}
 
 		return utilityOptions;
@@ -302,7 +308,7 @@ namespace TDEngine2
 	{
 		WriteOutput(std::string("\n").append("Process ").append(filename).append(" file... "));
 
-		if (std::unique_ptr<IInputStream> pFileStream{ new FileInputStream(filename) })
+		if (std::unique_ptr<IInputStream> pFileStream{ new MemoryMappedInputStream(filename) })
 		{
 			if (!pFileStream->Open())
 			{
@@ -310,11 +316,19 @@ namespace TDEngine2
 				return nullptr;
 			}
 
-			Lexer lexer{ *pFileStream };
-
 			std::unique_ptr<SymTable> pSymTable = std::make_unique<SymTable>();
 			pSymTable->SetSourceFilename(fs::canonical(filename).string());
 
+			// \note In tagged only mode a header without meta markers can't contribute to the output, so skip tokenization of it
+			if (options.mIsTaggedOnlyModeEnabled && !HasTypesMetaMarkers(pFileStream->GetContents()))
+			{
+				WriteOutput("Skipped (no meta markers)\n");
+				return pSymTable;
+			}
+
+			Lexer lexer{ *pFileStream };
+			lexer.TokenizeAll();
+
 			bool hasErrors = false;
 
 			Parser{ lexer, *pSymTable, options, [&filename, &hasErrors](auto&& error)
@@ -388,20 +402,24 @@ namespace TDEngine2
 
 	bool TCacheData::Load(const std::string& cacheSourceDirectory, const std::string& cacheFilename)
 	{
-		std::ifstream inputFile(fs::path(cacheSourceDirectory).concat(cacheFilename), std::ios::binary);
+		MemoryMappedInputStream inputFile(fs::path(cacheSourceDirectory).concat(cacheFilename).string());
 
-		defer([&inputFile]
+		if (!inputFile.Open())
 		{
-			inputFile.close();
-		});
+			return false;
+		}
+
+		BufferReaderArchive cacheArchive{ inputFile.GetContents() };
 
-		if (!inputFile.is_open())
+		uint32_t formatVersion = 0;
+
+		cacheArchive >> formatVersion;
+
+		if (formatVersion != mFormatVersion)
 		{
 			return false;
 		}
 
-		Archive<std::ifstream> cacheArchive{ inputFile };
-
 		cacheArchive >> mInputHash;
 		
 		size_t entitiesCount = 0;
@@ -409,12 +427,24 @@ namespace TDEngine2
 		cacheArchive >> entitiesCount;
 
 		std::string currPath;
-		std::string currHash;
+		TSymTableCacheEntry currEntry;
 
-		for (size_t i = 0; i < entitiesCount; ++i)
+		for (size_t i = 0; i < entitiesCount && !cacheArchive.HasFailed(); ++i)
 		{
-			cacheArchive >> currPath >> currHash;
-			mSymTablesTable.emplace(currPath, currHash);
+			cacheArchive >> currPath;
+			cacheArchive >> currEntry.mStamp.mSize >> currEntry.mStamp.mModificationTime >> currEntry.mStamp.mInode;
+			cacheArchive.ReadBytes(&currEntry.mContentHash, sizeof(THash128));
+
+			mSymTablesTable.emplace(currPath, currEntry);
+		}
+
+		cacheArchive.ReadBytes(&mLastRunDigest, sizeof(THash128));
+		cacheArchive >> mLastOutputStamp.mSize >> mLastOutputStamp.mModificationTime >> mLastOutputStamp.mInode;
+
+		if (cacheArchive.HasFailed()) // \note A truncated index is dropped entirely, all headers will be processed again
+		{
+			Reset();
+			return false;
 		}
 
 		return true;
@@ -422,14 +452,9 @@ namespace TDEngine2
 
 	bool TCacheData::Save(const std::string& cacheSourceDirectory, const std::string& cacheFilename)
 	{
-		std::ofstream cacheFile(fs::path(cacheSourceDirectory).concat(cacheFilename), std::ios::binary);
-
-		defer([&cacheFile]
-		{
-			cacheFile.close();
-		});
+		BufferWriterArchive cacheArchive;
 
-		Archive<std::ofstream> cacheArchive { cacheFile };
+		cacheArchive << mFormatVersion;
 
 		cacheArchive << mInputHash;
 
@@ -437,10 +462,17 @@ namespace TDEngine2
 
 		for (auto&& currSymTableInfo : mSymTablesTable)
 		{
-			cacheArchive << currSymTableInfo.first << currSymTableInfo.second;
+			const TSymTableCacheEntry& currEntry = currSymTableInfo.second;
+
+			cacheArchive << currSymTableInfo.first;
+			cacheArchive << currEntry.mStamp.mSize << currEntry.mStamp.mModificationTime << currEntry.mStamp.mInode;
+			cacheArchive.WriteBytes(&currEntry.mContentHash, sizeof(THash128)); // \note Hashes don't benefit from varints
 		}
 
-		return true;
+		cacheArchive.WriteBytes(&mLastRunDigest, sizeof(THash128));
+		cacheArchive << mLastOutputStamp.mSize << mLastOutputStamp.mModificationTime << mLastOutputStamp.mInode;
+
+		return cacheArchive.SaveToFile(fs::path(cacheSourceDirectory).concat(cacheFilename).string());
 	}
 
 	void TCacheData::Reset()
@@ -449,28 +481,31 @@ namespace TDEngine2
 
 		mInputHash.clear();
 		mSymTablesTable.clear();
+
+		mLastRunDigest = {};
+		mLastOutputStamp = {};
 	}
 
-	void TCacheData::AddSymTableEntity(const std::string& filePath, const std::string& fileHash)
+	void TCacheData::AddSymTableEntity(const std::string& filePath, const TSymTableCacheEntry& entry)
 	{
 		std::lock_guard<std::mutex> lock{ mMutex };
 
-		if (mSymTablesTable.find(filePath) == mSymTablesTable.cend())
-		{
-			mSymTablesTable.emplace(filePath, fileHash);
-			return;
-		}
-
-		mSymTablesTable[filePath] = fileHash;
+		mSymTablesTable[filePath] = entry;
 	}
 
-	bool TCacheData::Contains(const std::string& filePath, const std::string& fileHash) const
+	bool TCacheData::FindSymTableEntity(const std::string& filePath, TSymTableCacheEntry& outEntry) const
 	{
 		std::lock_guard<std::mutex> lock{ mMutex };
 
 		auto iter = mSymTablesTable.find(filePath);
-		
-		return (iter != mSymTablesTable.cend()) && (iter->second == fileHash);
+		if (iter == mSymTablesTable.cend())
+		{
+			return false;
+		}
+
+		outEntry = iter->second;
+
+		return true;
 	}
 
 	void TCacheData::SetInputHash(const std::string& hash)
@@ -485,6 +520,14 @@ namespace TDEngine2
 		std::swap(mSymTablesTable, table);
 	}
 
+	void TCacheData::SetLastRunInfo(const THash128& runDigest, const TFileStamp& outputStamp)
+	{
+		std::lock_guard<std::mutex> lock{ mMutex };
+
+		mLastRunDigest = runDigest;
+		mLastOutputStamp = outputStamp;
+	}
+
 	const TCacheData::TCacheIndexTable& TCacheData::GetSymTablesIndex() const
 	{
 		return mSymTablesTable;
@@ -495,6 +538,16 @@ namespace TDEngine2
 		return mInputHash;
 	}
 
+	const THash128& TCacheData::GetLastRunDigest() const
+	{
+		return mLastRunDigest;
+	}
+
+	const TFileStamp& TCacheData::GetLastOutputStamp() const
+	{
+		return mLastOutputStamp;
+	}
+
 
 	std::string GetHashFromInputFiles(const std::vector<std::string>& inputFiles)
 	{
@@ -515,22 +568,82 @@ namespace TDEngine2
 		return outputHashStr;
 	}
 
-	std::string GetHashFromFilePath(const std::string& value)
+	bool GetFileStamp(const std::string& filePath, TFileStamp& outStamp)
 	{
-		picosha2::hash256_one_by_one hashGenerator;
+#if defined(_WIN32)
+		struct _stat64 fileInfo;
+		if (_stat64(filePath.c_str(), &fileInfo) != 0)
+		{
+			return false;
+		}
 
-		hashGenerator.init();
-		hashGenerator.process(value.cbegin(), value.cend());
+		outStamp.mModificationTime = static_cast<int64_t>(fileInfo.st_mtime);
+		outStamp.mInode = 0;
+#else
+		struct stat fileInfo;
+		if (stat(filePath.c_str(), &fileInfo) != 0)
+		{
+			return false;
+		}
 
-		std::string timestampStr = std::to_string(static_cast<long long>(fs::last_write_time(value).time_since_epoch().count()));
-		hashGenerator.process(timestampStr.cbegin(), timestampStr.cend());
+	#if defined(__APPLE__)
+		outStamp.mModificationTime = static_cast<int64_t>(fileInfo.st_mtimespec.tv_sec) * 1000000000ll + fileInfo.st_mtimespec.tv_nsec;
+	#else
+		outStamp.mModificationTime = static_cast<int64_t>(fileInfo.st_mtim.tv_sec) * 1000000000ll + fileInfo.st_mtim.tv_nsec;
+	#endif
+		outStamp.mInode = static_cast<uint64_t>(fileInfo.st_ino);
+#endif
+		outStamp.mSize = static_cast<uint64_t>(fileInfo.st_size);
 
-		hashGenerator.finish();
+		return true;
+	}
 
-		std::string outputHashStr;
-		picosha2::get_hash_hex_string(hashGenerator, outputHashStr);
+	THash128 GetHashFromFileContent(const std::string& filePath)
+	{
+		MemoryMappedInputStream fileStream(filePath);
+		if (!fileStream.Open())
+		{
+			return THash128{};
+		}
 
-		return outputHashStr;
+		const THash128 hash = ComputeHash128(fileStream.GetContents());
+
+		fileStream.Close();
+
+		return hash;
+	}
+
+	std::string GetSymTableCacheFilename(const std::string& filePath, const THash128& contentHash)
+	{
+		return ComputeHash128(filePath).ToString().append(contentHash.ToString());
+	}
+
+	bool ComputeRunDigest(const TIntrospectorOptions& options, const std::vector<std::string>& headers, const TCacheData& cacheData, THash128& outDigest)
+	{
+		BufferWriterArchive digestArchive;
+
+		digestArchive << ToolVersion.mMajor << ToolVersion.mMinor;
+		digestArchive << options.mIsTaggedOnlyModeEnabled << options.mEmitFlags << options.mTypenamesPatternsToExcludeStr;
+		digestArchive << options.mOutputDirname << options.mOutputFilename;
+
+		digestArchive << headers.size();
+
+		TSymTableCacheEntry currEntry;
+
+		for (auto&& currHeaderPath : headers)
+		{
+			if (!cacheData.FindSymTableEntity(currHeaderPath, currEntry))
+			{
+				return false;
+			}
+
+			digestArchive << currHeaderPath;
+			digestArchive.WriteBytes(&currEntry.mContentHash, sizeof(THash128));
+		}
+
+		outDigest = ComputeHash128(digestArchive.GetBuffer());
+
+		return true;
 	}
 
 
@@ -0,0 +1,112 @@
+#include "../include/hash.h"
+#include <cstring>
+
+
+namespace TDEngine2
+{
+	std::string THash128::ToString() const
+	{
+		static constexpr char HexDigits[] = "0123456789abcdef";
+
+		std::string output(32, '0');
+
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			output[15 - i] = HexDigits[(mHigh >> (4 * i)) & 0xF];
+			output[31 - i] = HexDigits[(mLow >> (4 * i)) & 0xF];
+		}
+
+		return output;
+	}
+
+
+	static inline uint64_t RotateLeft(uint64_t value, uint32_t shift)
+	{
+		return (value << shift) | (value >> (64 - shift));
+	}
+
+	static inline uint64_t FinalizeMix(uint64_t value)
+	{
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ull;
+		value ^= value >> 33;
+
+		return value;
+	}
+
+	static inline uint64_t LoadWord(const uint8_t* pData)
+	{
+		uint64_t value;
+		std::memcpy(&value, pData, sizeof(value)); // \note Unaligned load, the hash assumes little-endian order of bytes
+
+		return value;
+	}
+
+
+	THash128 ComputeHash128(const void* pData, size_t size, uint64_t seed)
+	{
+		constexpr uint64_t c1 = 0x87c37b91114253d5ull;
+		constexpr uint64_t c2 = 0x4cf5ad432745937full;
+
+		const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+		const size_t blocksCount = size / 16;
+
+		uint64_t h1 = seed;
+		uint64_t h2 = seed;
+
+		for (size_t i = 0; i < blocksCount; ++i)
+		{
+			uint64_t k1 = LoadWord(pBytes + i * 16);
+			uint64_t k2 = LoadWord(pBytes + i * 16 + 8);
+
+			k1 *= c1; k1 = RotateLeft(k1, 31); k1 *= c2; h1 ^= k1;
+			h1 = RotateLeft(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+			k2 *= c2; k2 = RotateLeft(k2, 33); k2 *= c1; h2 ^= k2;
+			h2 = RotateLeft(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+		}
+
+		/// \note Process the rest bytes that don't fill the whole block
+		const uint8_t* pTail = pBytes + blocksCount * 16;
+		const size_t tailSize = size & 15;
+
+		uint64_t k1 = 0;
+		uint64_t k2 = 0;
+
+		for (size_t i = tailSize; i > 8; --i)
+		{
+			k2 ^= static_cast<uint64_t>(pTail[i - 1]) << (8 * (i - 9));
+		}
+
+		if (tailSize > 8)
+		{
+			k2 *= c2; k2 = RotateLeft(k2, 33); k2 *= c1; h2 ^= k2;
+		}
+
+		for (size_t i = (tailSize > 8 ? 8 : tailSize); i > 0; --i)
+		{
+			k1 ^= static_cast<uint64_t>(pTail[i - 1]) << (8 * (i - 1));
+		}
+
+		if (tailSize)
+		{
+			k1 *= c1; k1 = RotateLeft(k1, 31); k1 *= c2; h1 ^= k1;
+		}
+
+		h1 ^= static_cast<uint64_t>(size);
+		h2 ^= static_cast<uint64_t>(size);
+
+		h1 += h2;
+		h2 += h1;
+
+		h1 = FinalizeMix(h1);
+		h2 = FinalizeMix(h2);
+
+		h1 += h2;
+		h2 += h1;
+
+		return { h1, h2 };
+	}
+}
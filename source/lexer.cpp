@@ -1,5 +1,16 @@
 #include "../include/lexer.h"
-#include <cctype>
+#include "../include/scanners.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#if defined(_WIN32)
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
 
 
 namespace TDEngine2
@@ -55,94 +66,372 @@ namespace TDEngine2
 	}
 
 
-	const Lexer::TKeywordsMap Lexer::mReservedTokens
-	{
-		{ "namespace", E_TOKEN_TYPE::TT_NAMESPACE },
-		{ "enum", E_TOKEN_TYPE::TT_ENUM },
-		{ "class", E_TOKEN_TYPE::TT_CLASS },
-		{ "struct", E_TOKEN_TYPE::TT_STRUCT },
-		{ "union", E_TOKEN_TYPE::TT_UNION },
-		{ "public", E_TOKEN_TYPE::TT_PUBLIC },
-		{ "protected", E_TOKEN_TYPE::TT_PROTECTED },
-		{ "private", E_TOKEN_TYPE::TT_PRIVATE },
-		{ "virtual", E_TOKEN_TYPE::TT_VIRTUAL },
-		{ "override", E_TOKEN_TYPE::TT_OVERRIDE },
-		{ "final", E_TOKEN_TYPE::TT_FINAL },
-		{ "template", E_TOKEN_TYPE::TT_TEMPLATE },
-		{ "ENUM_META", E_TOKEN_TYPE::TT_ENUM_META_ATTRIBUTE },
-		{ "CLASS_META", E_TOKEN_TYPE::TT_CLASS_META_ATTRIBUTE },
-		{ "FIELD_META", E_TOKEN_TYPE::TT_FIELD_META_ATTRIBUTE },
-		{ "INTERFACE_META", E_TOKEN_TYPE::TT_INTERFACE_META_ATTRIBUTE },
-		{ "BEGIN_IGNORE_META_SECTION", E_TOKEN_TYPE::TT_BEGIN_IGNORE_SECTION },
-		{ "END_IGNORE_META_SECTION", E_TOKEN_TYPE::TT_END_IGNORE_SECTION },
-		{ "SECTION", E_TOKEN_TYPE::TT_SECTION_TAG_KEY },
-		{ "section", E_TOKEN_TYPE::TT_SECTION_TAG_KEY },
-		{ "NAME", E_TOKEN_TYPE::TT_NAME_TAG_KEY },
-		{ "name", E_TOKEN_TYPE::TT_NAME_TAG_KEY },
-		{ "FLAGS", E_TOKEN_TYPE::TT_FLAGS_TAG_KEY },
-		{ "flags", E_TOKEN_TYPE::TT_FLAGS_TAG_KEY },
-		{ "SERIALIZE_ALL_FIELDS", E_TOKEN_TYPE::TT_SERIALIZE_ALL_FIELDS_FLAG },
-		{ "SERIALIZE_MARKED_ONLY_FIELDS", E_TOKEN_TYPE::TT_SERIALIZE_MARKED_FIELDS_ONLY_FLAG },
-		{ "char", E_TOKEN_TYPE::TT_CHAR },
-		{ "char16_t", E_TOKEN_TYPE::TT_CHAR16_T },
-		{ "char32_t", E_TOKEN_TYPE::TT_CHAR32_T },
-		{ "wchar_t", E_TOKEN_TYPE::TT_WCHAR_T },
-		{ "bool", E_TOKEN_TYPE::TT_BOOL },
-		{ "short", E_TOKEN_TYPE::TT_SHORT },
-		{ "int", E_TOKEN_TYPE::TT_INT },
-		{ "long", E_TOKEN_TYPE::TT_LONG },
-		{ "signed", E_TOKEN_TYPE::TT_SIGNED },
-		{ "unsigned", E_TOKEN_TYPE::TT_UNSIGNED },
-		{ "float", E_TOKEN_TYPE::TT_FLOAT },
-		{ "double", E_TOKEN_TYPE::TT_DOUBLE },
-		{ "void", E_TOKEN_TYPE::TT_VOID },
-		{ "auto", E_TOKEN_TYPE::TT_AUTO },
-		{ "decltype", E_TOKEN_TYPE::TT_DECLTYPE },
-		{ "typedef", E_TOKEN_TYPE::TT_TYPEDEF },
-		{ "using", E_TOKEN_TYPE::TT_USING },
-		{ "static", E_TOKEN_TYPE::TT_STATIC },
-		{ "inline", E_TOKEN_TYPE::TT_INLINE },
-		{ "{", E_TOKEN_TYPE::TT_OPEN_BRACE },
-		{ "}", E_TOKEN_TYPE::TT_CLOSE_BRACE },
-		{ "(", E_TOKEN_TYPE::TT_OPEN_PARENTHES },
-		{ ")", E_TOKEN_TYPE::TT_CLOSE_PARENTHES },
-		{ ":", E_TOKEN_TYPE::TT_COLON },
-		{ ";", E_TOKEN_TYPE::TT_SEMICOLON },
-		{ "=", E_TOKEN_TYPE::TT_ASSIGN_OP },
-		{ ",", E_TOKEN_TYPE::TT_COMMA },
-		{ "<", E_TOKEN_TYPE::TT_LESS },
-		{ ">", E_TOKEN_TYPE::TT_GREAT },
-		{ "|", E_TOKEN_TYPE::TT_PIPE },
-		{ "->", E_TOKEN_TYPE::TT_ARROW },
-		{ "++", E_TOKEN_TYPE::TT_INCREMENT },
-		{ "--", E_TOKEN_TYPE::TT_DECREMENT },
-		{ "<<", E_TOKEN_TYPE::TT_LEFT_SHIFT },
-		{ ">>", E_TOKEN_TYPE::TT_RIGHT_SHIFT },
-	};
+	MemoryMappedInputStream::MemoryMappedInputStream(const std::string& filename):
+		mFilename(filename)
+	{
+	}
+
+	MemoryMappedInputStream::~MemoryMappedInputStream()
+	{
+		Close();
+	}
+
+	bool MemoryMappedInputStream::Open()
+	{
+		if (mIsOpened || mFilename.empty())
+		{
+			return false;
+		}
+
+#if defined(_WIN32)
+		HANDLE fileHandle = CreateFileA(mFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (INVALID_HANDLE_VALUE == fileHandle)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(fileHandle, &fileSize))
+		{
+			CloseHandle(fileHandle);
+			return false;
+		}
+
+		mpFileHandle = fileHandle;
+		mSize = static_cast<size_t>(fileSize.QuadPart);
+
+		if (mSize) // \note Empty files can't be mapped
+		{
+			HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!mappingHandle)
+			{
+				CloseHandle(fileHandle);
+				mpFileHandle = nullptr;
+
+				return false;
+			}
+
+			mpMappingHandle = mappingHandle;
+			mpData = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		}
+#else
+		const int fileDescriptor = open(mFilename.c_str(), O_RDONLY);
+		if (fileDescriptor < 0)
+		{
+			return false;
+		}
+
+		struct stat fileInfo;
+		if (fstat(fileDescriptor, &fileInfo) < 0)
+		{
+			close(fileDescriptor);
+			return false;
+		}
+
+		mSize = static_cast<size_t>(fileInfo.st_size);
+
+		if (mSize) // \note Empty files can't be mapped
+		{
+			void* pMappedData = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+			if (MAP_FAILED != pMappedData)
+			{
+				mpData = static_cast<const char*>(pMappedData);
+				madvise(pMappedData, mSize, MADV_SEQUENTIAL);
+			}
+		}
+
+		close(fileDescriptor); // \note The mapping keeps its own reference to the file
+#endif
+
+		if (mSize && !mpData)
+		{
+			mIsOpened = true;
+			Close();
+
+			return false;
+		}
+
+		mReadPosition = 0;
+		mIsOpened = true;
+
+		return true;
+	}
+
+	bool MemoryMappedInputStream::Close()
+	{
+		if (!mIsOpened)
+		{
+			return false;
+		}
+
+#if defined(_WIN32)
+		if (mpData)
+		{
+			UnmapViewOfFile(mpData);
+		}
+
+		if (mpMappingHandle)
+		{
+			CloseHandle(static_cast<HANDLE>(mpMappingHandle));
+		}
+
+		if (mpFileHandle)
+		{
+			CloseHandle(static_cast<HANDLE>(mpFileHandle));
+		}
+
+		mpMappingHandle = nullptr;
+		mpFileHandle = nullptr;
+#else
+		if (mpData)
+		{
+			munmap(const_cast<char*>(mpData), mSize);
+		}
+#endif
+
+		mpData = nullptr;
+		mSize = 0;
+		mReadPosition = 0;
+		mIsOpened = false;
+
+		return true;
+	}
+
+	std::string MemoryMappedInputStream::ReadLine()
+	{
+		if (!mIsOpened || mReadPosition >= mSize)
+		{
+			return std::string();
+		}
+
+		const std::string_view contents = GetContents().substr(mReadPosition);
+		const size_t lineLength = std::min<size_t>(contents.find('\n'), contents.size() - 1) + 1; // \note Include '\n' if it exists
+
+		mReadPosition += lineLength;
+
+		return std::string(contents.substr(0, lineLength));
+	}
+
+	std::string_view MemoryMappedInputStream::GetContents() const
+	{
+		return mpData ? std::string_view(mpData, mSize) : std::string_view();
+	}
+
+
+	bool HasTypesMetaMarkers(std::string_view sourceText)
+	{
+		static const std::string_view markerSuffix = "_META";
+		static const std::string_view markerPrefixes[] { "ENUM", "CLASS", "INTERFACE" };
+
+		const TTextScannersTable& scanners = GetTextScanners();
+
+		const char* pTextBegin = sourceText.data();
+		const char* pTextEnd = pTextBegin + sourceText.size();
+
+		// \note All markers share the same suffix, so search it and check a prefix then
+		for (const char* pCurrPos = pTextBegin; pCurrPos < pTextEnd; ++pCurrPos)
+		{
+			pCurrPos = scanners.mpFindSubstring(pCurrPos, pTextEnd, markerSuffix.data(), markerSuffix.size());
+			if (pCurrPos == pTextEnd)
+			{
+				break;
+			}
+
+			const std::string_view precedingText = sourceText.substr(0, static_cast<size_t>(pCurrPos - pTextBegin));
+
+			for (std::string_view currPrefix : markerPrefixes)
+			{
+				if (precedingText.size() >= currPrefix.size() && precedingText.substr(precedingText.size() - currPrefix.size()) == currPrefix)
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+
+	static bool IsEscapedChar(const char* pLiteralBegin, const char* pChar)
+	{
+		size_t backslashesCount = 0;
+
+		for (; pChar > pLiteralBegin && *(pChar - 1) == '\\'; --pChar)
+		{
+			++backslashesCount;
+		}
+
+		return backslashesCount & 1;
+	}
+
+	/*!
+		\brief The function returns a pointer to a character that follows the closing quote. An unterminated literal ends
+		at the end of its line, so a single stray quote can't swallow the rest of the file
+	*/
+
+	static const char* FindQuotedLiteralEnd(const char* pBegin, const char* pEnd, char quote)
+	{
+		const char* pCurrPos = pBegin;
+
+		while (pCurrPos < pEnd)
+		{
+			const char* pQuote = static_cast<const char*>(std::memchr(pCurrPos, quote, static_cast<size_t>(pEnd - pCurrPos)));
+			const char* pSearchEnd = pQuote ? pQuote : pEnd;
+
+			// \note Check there is no line's end before the quote, skip escaped ones (line continuations)
+			for (const char* pLineEnd = pCurrPos; (pLineEnd = static_cast<const char*>(std::memchr(pLineEnd, '\n', static_cast<size_t>(pSearchEnd - pLineEnd)))); ++pLineEnd)
+			{
+				if (!IsEscapedChar(pBegin, pLineEnd))
+				{
+					return pLineEnd;
+				}
+			}
+
+			if (!pQuote)
+			{
+				break;
+			}
+
+			if (!IsEscapedChar(pBegin, pQuote))
+			{
+				return pQuote + 1;
+			}
+
+			pCurrPos = pQuote + 1;
+		}
+
+		return pEnd;
+	}
+
+	/*!
+		\brief The function returns a pointer to a character that follows R"delimiter(...)delimiter" literal, pBegin should point
+		to the first character of the delimiter. Returns nullptr if the delimiter isn't valid
+	*/
+
+	static const char* FindRawStringLiteralEnd(const TTextScannersTable& scanners, const char* pBegin, const char* pEnd)
+	{
+		constexpr size_t maxDelimiterLength = 16;
+
+		const char* pDelimiterEnd = static_cast<const char*>(std::memchr(pBegin, '(', std::min<size_t>(maxDelimiterLength + 1, static_cast<size_t>(pEnd - pBegin))));
+		if (!pDelimiterEnd)
+		{
+			return nullptr;
+		}
+
+		const size_t delimiterLength = static_cast<size_t>(pDelimiterEnd - pBegin);
+
+		char terminator[maxDelimiterLength + 2]; // \note )delimiter"
+		terminator[0] = ')';
+		std::memcpy(terminator + 1, pBegin, delimiterLength);
+		terminator[delimiterLength + 1] = '"';
+
+		const size_t terminatorLength = delimiterLength + 2;
+
+		const char* pTerminator = scanners.mpFindSubstring(pDelimiterEnd + 1, pEnd, terminator, terminatorLength);
+		return (pTerminator == pEnd) ? pEnd : (pTerminator + terminatorLength);
+	}
+
+	/*!
+		\brief The function checks whether a quote starts a raw string, so it's preceded by R, u8R, uR, UR or LR prefix
+	*/
+
+	static bool IsRawStringLiteralPrefix(const char* pTextBegin, const char* pQuote)
+	{
+		if (pQuote == pTextBegin || *(pQuote - 1) != 'R')
+		{
+			return false;
+		}
+
+		const char* pPrefixBegin = pQuote - 1;
+
+		if (pPrefixBegin - pTextBegin >= 2 && *(pPrefixBegin - 2) == 'u' && *(pPrefixBegin - 1) == '8')
+		{
+			pPrefixBegin -= 2;
+		}
+		else if (pPrefixBegin > pTextBegin && (*(pPrefixBegin - 1) == 'u' || *(pPrefixBegin - 1) == 'U' || *(pPrefixBegin - 1) == 'L'))
+		{
+			--pPrefixBegin;
+		}
+
+		return pPrefixBegin == pTextBegin || !IsIdentifierChar(*(pPrefixBegin - 1));
+	}
+
+	/*!
+		\brief The function checks whether a single quote is a digits separator (1'000) instead of the beginning of a character literal
+	*/
+
+	static bool IsDigitsSeparator(const char* pTextBegin, const char* pQuote)
+	{
+		const char* pNumberBegin = pQuote;
+
+		while (pNumberBegin > pTextBegin && (IsIdentifierChar(*(pNumberBegin - 1)) || *(pNumberBegin - 1) == '\'' || *(pNumberBegin - 1) == '.'))
+		{
+			--pNumberBegin;
+		}
+
+		return pNumberBegin != pQuote && (IsDigitChar(*pNumberBegin) || *pNumberBegin == '.');
+	}
+
 
 	Lexer::Lexer(IInputStream& streamSource):
-		mpStream(&streamSource), mCurrProcessedText()
+		mpStream(&streamSource), mSourceText(), mpScanners(&GetTextScanners())
 	{
 	}
 
 	const TToken& Lexer::GetCurrToken()
 	{
-		if (mTokensQueue.empty() && !mLastScannedToken.mIsValid)
+		if (!mTokensBufferSize)
 		{
 			return GetNextToken();
 		}
 
-		return mLastScannedToken;
+		return mTokensBuffer[mTokensBufferHead];
 	}
 
 
 	TToken Lexer::_skipIgnoredTokensSection()
 	{
-		TToken currToken = _scanToken();
+		static constexpr std::string_view endMarker = "END_IGNORE_META_SECTION";
 
-		while (E_TOKEN_TYPE::TT_EOF != currToken.mType && E_TOKEN_TYPE::TT_END_IGNORE_SECTION != currToken.mType)
+		const char* pTextBegin = mSourceText.data();
+		const char* pTextEnd = pTextBegin + mSourceText.size();
+
+		const char* pMarker = nullptr;
+
+		// \note Search the marker in the raw text and check there are no comments or literals before it that could contain it
+		while (mCursor < mSourceText.size())
 		{
-			currToken = _scanToken();
+			const char* pCurrPos = pTextBegin + mCursor;
+
+			if (!pMarker || pMarker < pCurrPos)
+			{
+				pMarker = mpScanners->mpFindSubstring(pCurrPos, pTextEnd, endMarker.data(), endMarker.size());
+			}
+
+			if (pMarker == pTextEnd)
+			{
+				_moveCursorTo(pTextEnd);
+				break;
+			}
+
+			const char* pDelimiter = mpScanners->mpFindBalancedTextDelimiter(pCurrPos, pMarker);
+			if (pDelimiter != pMarker)
+			{
+				_moveCursorTo(pDelimiter);
+				_skipNonCodeText();
+
+				continue;
+			}
+
+			const char* pMarkerEnd = pMarker + endMarker.size();
+
+			if ((pMarker == pTextBegin || !IsIdentifierChar(*(pMarker - 1))) && (pMarkerEnd == pTextEnd || !IsIdentifierChar(*pMarkerEnd)))
+			{
+				_moveCursorTo(pMarkerEnd - 1);
+				break;
+			}
+
+			_moveCursorTo(pMarker); // \note The marker is a part of another identifier, continue the search after its first character
 		}
 
 		return _scanToken(); // \note Scan next token right after END_IGNORE_META_SECTION keyword
@@ -173,121 +462,383 @@ namespace TDEngine2
 
 	const TToken& Lexer::GetNextToken()
 	{
-		if (!mTokensQueue.empty())
+		if (mTokensBufferSize)
 		{
-			mLastScannedToken = mTokensQueue.front();
-			mTokensQueue.erase(mTokensQueue.cbegin());
+			mTokensBufferHead = (mTokensBufferHead + 1) & (mTokensBufferCapacity - 1);
+			--mTokensBufferSize;
+		}
 
-			return mLastScannedToken;
+		if (!mTokensBufferSize) // \note There are no lookahead tokens, so scan a new one right in place
+		{
+			mTokensBuffer[mTokensBufferHead] = _fetchNextToken();
+			mTokensBufferSize = 1;
 		}
 
-		mLastScannedToken = _getNextTokenImpl();
-		return mLastScannedToken;
+		return mTokensBuffer[mTokensBufferHead];
 	}
 
 	const TToken& Lexer::PeekToken(uint32_t offset)
 	{
+		assert(offset < mTokensBufferCapacity);
+
 		if (!offset)
 		{
-			mTokensQueue.emplace_back(std::move(_getNextTokenImpl()));
-			return mTokensQueue.front();
+			return GetCurrToken();
 		}
 
-		if (size_t pos = static_cast<size_t>(offset); pos < mTokensQueue.size())
+		if (!mTokensBufferSize)
 		{
-			return mTokensQueue[pos];
+			GetCurrToken();
 		}
 
-		const size_t count = static_cast<size_t>(offset - mTokensQueue.size());
-
-		for (size_t i = 0; i < count; ++i)
+		while (mTokensBufferSize <= offset)
 		{
-			mTokensQueue.emplace_back(std::move(_getNextTokenImpl()));
+			mTokensBuffer[(mTokensBufferHead + mTokensBufferSize) & (mTokensBufferCapacity - 1)] = _fetchNextToken();
+			++mTokensBufferSize;
 		}
 
-		return mTokensQueue.back();
+		return mTokensBuffer[(mTokensBufferHead + offset) & (mTokensBufferCapacity - 1)];
 	}
 
-	void Lexer::SetTemplateArgsParsingMode(bool state)
+	bool Lexer::SkipBalancedTokens()
 	{
-		mIsTemplateArgsParsingModeEnabled = state;
-	}
+		const TToken& currToken = GetCurrToken();
 
-	void Lexer::SetMetaTagParsingMode(bool state)
-	{
-		mIsMetaTagParsingModeEnabled = state;
-	}
+		E_TOKEN_TYPE closeTokenType = E_TOKEN_TYPE::TT_EOF;
+		char openChar = '\0';
+		char closeChar = '\0';
 
-	TToken Lexer::_scanToken()
-	{
-		char ch = ' ';
+		switch (currToken.mType)
+		{
+			case E_TOKEN_TYPE::TT_OPEN_BRACE:
+				closeTokenType = E_TOKEN_TYPE::TT_CLOSE_BRACE;
+				openChar = '{';
+				closeChar = '}';
+				break;
+			case E_TOKEN_TYPE::TT_OPEN_PARENTHES:
+				closeTokenType = E_TOKEN_TYPE::TT_CLOSE_PARENTHES;
+				openChar = '(';
+				closeChar = ')';
+				break;
+			default:
+				return false;
+		}
+
+		if (mIsTokenized) // \note Matching tokens are already known, so just jump to the closing one
+		{
+			const auto& offsets = mTokensStorage.mOffsets;
+			const size_t currTokenIndex = static_cast<size_t>(std::lower_bound(offsets.cbegin(), offsets.cend(), currToken.mOffset) - offsets.cbegin());
+
+			mNextStoredTokenIndex = mTokensStorage.mMatchingTokenIndices[currTokenIndex];
+			mIsSplitTokenPending = false;
 
-		TToken recognizedToken{};
+			mTokensBuffer[mTokensBufferHead] = _fetchNextToken();
+			mTokensBufferSize = 1;
+
+			return closeTokenType == mTokensBuffer[mTokensBufferHead].mType;
+		}
 
-		while ((ch = _getNextChar()) != EOF)
+		uint32_t depth = 1;
+
+		// \note Lookahead tokens are already scanned, so the text after them is processed only
+		for (uint32_t i = 1; i < mTokensBufferSize; ++i)
 		{
-			if (_skipComments())
+			const uint32_t tokenIndex = (mTokensBufferHead + i) & (mTokensBufferCapacity - 1);
+			const E_TOKEN_TYPE tokenType = mTokensBuffer[tokenIndex].mType;
+
+			if (tokenType == currToken.mType)
 			{
+				++depth;
 				continue;
 			}
 
-			_skipWhitespaces();
+			if ((tokenType == closeTokenType && !--depth) || E_TOKEN_TYPE::TT_EOF == tokenType)
+			{
+				mTokensBufferHead = tokenIndex;
+				mTokensBufferSize -= i;
+
+				return E_TOKEN_TYPE::TT_EOF != tokenType;
+			}
+		}
+
+		mTokensBufferSize = 1;
+
+		if (_skipBalancedText(openChar, closeChar, depth))
+		{
+			mTokensBuffer[mTokensBufferHead] = TToken(closeTokenType, mSourceText.substr(mCursor - 1, 1), static_cast<uint32_t>(mCursor - 1));
+			return true;
+		}
+
+		mTokensBuffer[mTokensBufferHead] = TToken(E_TOKEN_TYPE::TT_EOF, std::string_view(), static_cast<uint32_t>(mSourceText.size()));
+
+		return false;
+	}
+
+	void Lexer::TokenizeAll()
+	{
+		if (mIsTokenized)
+		{
+			return;
+		}
+
+		_fetchSourceText();
 
-			if (_skipMacroDefinitions())
+		const bool prevTemplateArgsParsingMode = mIsTemplateArgsParsingModeEnabled;
+		const bool prevMetaTagParsingMode = mIsMetaTagParsingModeEnabled;
+
+		// \note Scan in mode neutral way, the modes are applied in _fetchNextToken
+		mIsTemplateArgsParsingModeEnabled = false;
+		mIsMetaTagParsingModeEnabled = true;
+
+		const size_t expectedTokensCount = mSourceText.size() / 6; // \note A rough estimation for headers with comments
+
+		mTokensStorage.mTypes.reserve(expectedTokensCount);
+		mTokensStorage.mOffsets.reserve(expectedTokensCount);
+		mTokensStorage.mLengths.reserve(expectedTokensCount);
+		mTokensStorage.mMatchingTokenIndices.reserve(expectedTokensCount);
+
+		auto pushToken = [this](const TToken& token)
+		{
+			mTokensStorage.mTypes.push_back(token.mType);
+			mTokensStorage.mOffsets.push_back(token.mOffset);
+			mTokensStorage.mLengths.push_back(static_cast<uint32_t>(token.mValue.size()));
+			mTokensStorage.mMatchingTokenIndices.push_back(0);
+
+			return static_cast<uint32_t>(mTokensStorage.mTypes.size() - 1);
+		};
+
+		std::vector<uint32_t> openBracesIndices;
+		std::vector<uint32_t> openParenthesesIndices;
+
+		auto matchToken = [this](std::vector<uint32_t>& openTokensIndices, uint32_t closeTokenIndex)
+		{
+			if (!openTokensIndices.empty())
 			{
-				continue;
+				mTokensStorage.mMatchingTokenIndices[openTokensIndices.back()] = closeTokenIndex;
+				openTokensIndices.pop_back();
 			}
+		};
 
-			ch = _getCurrChar();
+		bool isFunctionBodyExpected = false; // \note It's true after ) that could be followed by const, noexcept, override or final
+
+		while (true)
+		{
+			const TToken currToken = _getNextTokenImpl();
+			const uint32_t currTokenIndex = pushToken(currToken);
 
-			if (auto numberToken = _parseNumbers())
+			switch (currToken.mType)
 			{
-				return *numberToken;
+				case E_TOKEN_TYPE::TT_OPEN_BRACE:
+					if (!isFunctionBodyExpected)
+					{
+						openBracesIndices.push_back(currTokenIndex);
+						break;
+					}
+
+					// \note The parser never looks into bodies of functions, so skip them without tokenization
+					if (_skipBalancedText('{', '}'))
+					{
+						mTokensStorage.mMatchingTokenIndices[currTokenIndex] = pushToken(TToken(E_TOKEN_TYPE::TT_CLOSE_BRACE, mSourceText.substr(mCursor - 1, 1), static_cast<uint32_t>(mCursor - 1)));
+					}
+					else
+					{
+						openBracesIndices.push_back(currTokenIndex);
+					}
+					break;
+				case E_TOKEN_TYPE::TT_CLOSE_BRACE:
+					matchToken(openBracesIndices, currTokenIndex);
+					break;
+				case E_TOKEN_TYPE::TT_OPEN_PARENTHES:
+					openParenthesesIndices.push_back(currTokenIndex);
+					break;
+				case E_TOKEN_TYPE::TT_CLOSE_PARENTHES:
+					matchToken(openParenthesesIndices, currTokenIndex);
+					break;
+				default:
+					break;
 			}
 
-			if (auto keywordToken = _parseReservedKeywordsAndIdentifiers())
+			switch (currToken.mType)
 			{
-				return *keywordToken;
+				case E_TOKEN_TYPE::TT_CLOSE_PARENTHES:
+					isFunctionBodyExpected = true;
+					break;
+				case E_TOKEN_TYPE::TT_OVERRIDE:
+				case E_TOKEN_TYPE::TT_FINAL:
+					break;
+				case E_TOKEN_TYPE::TT_IDENTIFIER:
+					isFunctionBodyExpected = isFunctionBodyExpected && (currToken.mValue == "const" || currToken.mValue == "noexcept" || currToken.mValue == "volatile");
+					break;
+				default:
+					isFunctionBodyExpected = false;
+					break;
 			}
 
-			return TToken(E_TOKEN_TYPE::TT_UNKNOWN, "", std::tuple<uint32_t, uint32_t>(mCurrHorPosIndex, mCurrLineIndex));
+			if (E_TOKEN_TYPE::TT_EOF == currToken.mType)
+			{
+				// \note Unmatched tokens refer to EOF
+				for (uint32_t currIndex : openBracesIndices)
+				{
+					mTokensStorage.mMatchingTokenIndices[currIndex] = currTokenIndex;
+				}
+
+				for (uint32_t currIndex : openParenthesesIndices)
+				{
+					mTokensStorage.mMatchingTokenIndices[currIndex] = currTokenIndex;
+				}
+
+				break;
+			}
 		}
 
-		/*while (!eof)
-		{
-			skip whitespaces
-			skip comments
-			read literals
-			read identifiers and keywords
-		}*/
+		mIsTemplateArgsParsingModeEnabled = prevTemplateArgsParsingMode;
+		mIsMetaTagParsingModeEnabled = prevMetaTagParsingMode;
 
-		return TToken(E_TOKEN_TYPE::TT_EOF);
+		mNextStoredTokenIndex = 0;
+		mIsTokenized = true;
 	}
 
-	void Lexer::_skipWhitespaces()
+	const TTokensStorage& Lexer::GetTokensStorage() const
+	{
+		return mTokensStorage;
+	}
+
+	TToken Lexer::_fetchNextToken()
 	{
-		char ch = '\0';
+		if (!mIsTokenized)
+		{
+			return _getNextTokenImpl();
+		}
+
+		const size_t index = mNextStoredTokenIndex;
 
-		bool skipped = false;
+		E_TOKEN_TYPE type = mTokensStorage.mTypes[index];
 
-		while (std::isspace(ch = _getCurrChar()))
+		const uint32_t offset = mTokensStorage.mOffsets[index];
+
+		if (E_TOKEN_TYPE::TT_EOF == type)
 		{
-			while (std::isspace(ch = _getCurrChar()))
-			{
-				if (ch == '\n' || ch == '\r')
+			return TToken(E_TOKEN_TYPE::TT_EOF, std::string_view(), offset); // \note The last token is always EOF, so the index stays here
+		}
+
+		if (mIsSplitTokenPending) // \note Return the second half of >>
+		{
+			mIsSplitTokenPending = false;
+			++mNextStoredTokenIndex;
+
+			return TToken(E_TOKEN_TYPE::TT_GREAT, mSourceText.substr(offset + 1, 1), offset + 1);
+		}
+
+		switch (type)
+		{
+			case E_TOKEN_TYPE::TT_RIGHT_SHIFT:
+				if (mIsTemplateArgsParsingModeEnabled)
+				{
+					mIsSplitTokenPending = true;
+					return TToken(E_TOKEN_TYPE::TT_GREAT, mSourceText.substr(offset, 1), offset);
+				}
+				break;
+			case E_TOKEN_TYPE::TT_SECTION_TAG_KEY:
+			case E_TOKEN_TYPE::TT_NAME_TAG_KEY:
+			case E_TOKEN_TYPE::TT_FLAGS_TAG_KEY:
+			case E_TOKEN_TYPE::TT_SERIALIZE_ALL_FIELDS_FLAG:
+			case E_TOKEN_TYPE::TT_SERIALIZE_MARKED_FIELDS_ONLY_FLAG:
+				if (!mIsMetaTagParsingModeEnabled)
 				{
-					mCurrHorPosIndex = 0;
-					++mCurrLineIndex;
+					type = E_TOKEN_TYPE::TT_IDENTIFIER;
 				}
+				break;
+			default:
+				break;
+		}
 
-				_getNextChar();
-			}
+		++mNextStoredTokenIndex;
+
+		return TToken(type, mSourceText.substr(offset, mTokensStorage.mLengths[index]), offset);
+	}
+
+	void Lexer::SetTemplateArgsParsingMode(bool state)
+	{
+		mIsTemplateArgsParsingModeEnabled = state;
+	}
+
+	void Lexer::SetMetaTagParsingMode(bool state)
+	{
+		mIsMetaTagParsingModeEnabled = state;
+	}
+
+	TToken Lexer::_scanToken()
+	{
+		char ch = _getNextChar();
 
-			if (_skipComments())
+		// \note The class of the current character defines which scanner should process it, so there is a single lookup per token's beginning
+		while (ch != EOF)
+		{
+			switch (GetCharClass(ch))
 			{
-				_getNextChar();
+				case E_CHAR_CLASS::WHITESPACE:
+					_skipWhitespaces();
+					ch = _getCurrChar(); // \note The cursor is already placed at the next meaningful character
+					continue;
+
+				case E_CHAR_CLASS::SLASH:
+					if (!_skipComments())
+					{
+						return _parsePunctuators();
+					}
+					break;
+
+				case E_CHAR_CLASS::HASH:
+					_skipMacroDefinitions();
+					break;
+
+				case E_CHAR_CLASS::DIGIT:
+				case E_CHAR_CLASS::DOT:
+					if (auto numberToken = _parseNumbers())
+					{
+						return *numberToken;
+					}
+
+					return _parsePunctuators();
+
+				case E_CHAR_CLASS::QUOTE:
+					if (auto literalToken = _parseStringLiterals())
+					{
+						return *literalToken;
+					}
+
+					return _parsePunctuators();
+
+				case E_CHAR_CLASS::LITERAL_PREFIX:
+					if (auto literalToken = _parseStringLiterals())
+					{
+						return *literalToken;
+					}
+
+					return _parseReservedKeywordsAndIdentifiers();
+
+				case E_CHAR_CLASS::IDENTIFIER_START:
+					return _parseReservedKeywordsAndIdentifiers();
+
+				case E_CHAR_CLASS::PUNCTUATOR:
+					return _parsePunctuators();
+
+				default:
+					return TToken(E_TOKEN_TYPE::TT_UNKNOWN, mSourceText.substr(mCursor - 1, 1), static_cast<uint32_t>(mCursor - 1));
 			}
-		}		
+
+			ch = _getNextChar();
+		}
+
+		return TToken(E_TOKEN_TYPE::TT_EOF, std::string_view(), static_cast<uint32_t>(mSourceText.size()));
+	}
+
+	void Lexer::_skipWhitespaces()
+	{
+		if (IsWhitespace(_getCurrChar()))
+		{
+			_moveCursorTo(mpScanners->mpSkipWhitespaces(mSourceText.data() + mCursor - 1, mSourceText.data() + mSourceText.size()));
+		}
 	}
 
 	bool Lexer::_skipMacroDefinitions()
@@ -319,133 +870,238 @@ namespace TDEngine2
 
 	char Lexer::_getCurrChar() const
 	{
-		return mCurrProcessedText.empty() ? EOF : mCurrProcessedText.front();
+		return (mCursor > 0 && mCursor <= mSourceText.size()) ? mSourceText[mCursor - 1] : EOF;
 	}
 
 	char Lexer::_getNextChar()
 	{
-		if (!mCurrProcessedText.empty())
-		{
-			mCurrProcessedText.erase(0, 1);
-		}
+		_fetchSourceText();
 
-		if (mCurrProcessedText.empty())
+		if (mCursor <= mSourceText.size())
 		{
-			mCurrProcessedText.append(mpStream->ReadLine());
+			++mCursor;
 		}
 
-		if (mCurrProcessedText.empty()) // \note if it's still empty then we've reached end of the text
+		if (mCursor > mSourceText.size()) // \note we've reached end of the text
 		{
 			return EOF;
 		}
 
-		++mCurrHorPosIndex;
+		return mSourceText[mCursor - 1];
+	}
 
-		return mCurrProcessedText.front();
+	void Lexer::_moveCursorTo(const char* pNextChar)
+	{
+		mCursor = static_cast<size_t>(pNextChar - mSourceText.data()) + 1;
 	}
 
-	char Lexer::_peekNextChar(uint32_t offset)
+	TToken::TCursorPos Lexer::GetCursorPosition(uint32_t offset)
 	{
-		if (offset >= mCurrProcessedText.size())
+		_fetchSourceText();
+
+		if (mLinesStartPositions.empty())
 		{
-			mCurrProcessedText.append(mpStream->ReadLine());
+			const char* pTextBegin = mSourceText.data();
+			const char* pTextEnd = pTextBegin + mSourceText.size();
+
+			mLinesStartPositions.push_back(0);
+
+			for (const char* pCurrPos = mpScanners->mpFindLineEnd(pTextBegin, pTextEnd); pCurrPos != pTextEnd; pCurrPos = mpScanners->mpFindLineEnd(pCurrPos + 1, pTextEnd))
+			{
+				mLinesStartPositions.push_back(static_cast<uint32_t>(pCurrPos - pTextBegin) + 1);
+			}
 		}
 
-		if (mCurrProcessedText.empty())
+		auto it = std::upper_bound(mLinesStartPositions.cbegin(), mLinesStartPositions.cend(), offset);
+		const size_t lineIndex = static_cast<size_t>(std::distance(mLinesStartPositions.cbegin(), it)) - 1;
+
+		return { offset - mLinesStartPositions[lineIndex] + 1, static_cast<uint32_t>(lineIndex + 1) };
+	}
+
+	char Lexer::_peekNextChar(uint32_t offset)
+	{
+		_fetchSourceText();
+
+		const size_t position = mCursor + static_cast<size_t>(offset);
+
+		if (!position || position > mSourceText.size())
 		{
 			return EOF;
 		}
 
-		return mCurrProcessedText[offset];
+		return mSourceText[position - 1];
 	}
 
-	std::optional<TToken> Lexer::_parseNumbers()
+	void Lexer::_fetchSourceText()
 	{
-		return std::nullopt;
+		if (mIsSourceTextFetched)
+		{
+			return;
+		}
+
+		mIsSourceTextFetched = true;
+
+		mSourceText = mpStream->GetContents();
+		if (!mSourceText.empty())
+		{
+			return;
+		}
+
+		// \note The stream doesn't keep its contents in memory, so read it once into the owned buffer
+		for (std::string currLine = mpStream->ReadLine(); !currLine.empty(); currLine = mpStream->ReadLine())
+		{
+			mOwnedSourceText.append(currLine);
+		}
+
+		mSourceText = mOwnedSourceText;
 	}
 
-	std::optional<TToken> Lexer::_parseReservedKeywordsAndIdentifiers()
+	std::optional<TToken> Lexer::_parseNumbers()
 	{
-		char ch = _getCurrChar();
+		const size_t tokenStartPos = mCursor - 1;
 
-		std::string possibleIdentifier{ ch };
+		const char ch = _getCurrChar();
+		if (!IsDigitChar(ch) && (ch != '.' || !IsDigitChar(_peekNextChar(1))))
+		{
+			return std::nullopt;
+		}
+
+		const char* pSourceTextEnd = mSourceText.data() + mSourceText.size();
+		const char* pCurrPos = mSourceText.data() + mCursor;
 
-		// \note try to detect identifier
-		if (std::isalpha(ch) || ch == '_')
+		// \note Consume a whole preprocessing number, so hex, binary, floating point literals and suffixes are covered
+		while (pCurrPos < pSourceTextEnd)
 		{
-			while (((ch = _peekNextChar(1)) != EOF) && (std::isalnum(ch) || ch == '_'))
+			const char currCh = *pCurrPos;
+
+			if (IsIdentifierChar(currCh) || currCh == '.')
 			{
-				possibleIdentifier.push_back(ch);
-				_getNextChar();
+				++pCurrPos;
+				continue;
 			}
 
-			auto&& iter = mReservedTokens.find(possibleIdentifier);
-			if (iter != mReservedTokens.cend())
+			const char prevCh = *(pCurrPos - 1) | 0x20; // \note to lower case
+
+			if ((currCh == '+' || currCh == '-') && (prevCh == 'e' || prevCh == 'p')) // \note exponent's sign
 			{
-				if (!mIsMetaTagParsingModeEnabled &&
-					(iter->second == E_TOKEN_TYPE::TT_SECTION_TAG_KEY ||
-					iter->second == E_TOKEN_TYPE::TT_NAME_TAG_KEY ||
-					iter->second == E_TOKEN_TYPE::TT_FLAGS_TAG_KEY ||
-					iter->second == E_TOKEN_TYPE::TT_SERIALIZE_ALL_FIELDS_FLAG ||
-					iter->second == E_TOKEN_TYPE::TT_SERIALIZE_MARKED_FIELDS_ONLY_FLAG))
-				{
-					return TToken{ E_TOKEN_TYPE::TT_IDENTIFIER, possibleIdentifier, { mCurrHorPosIndex, mCurrLineIndex } };
-				}
+				++pCurrPos;
+				continue;
+			}
 
-				return TToken{ iter->second, possibleIdentifier, { mCurrHorPosIndex, mCurrLineIndex } };
+			if (currCh == '\'' && (pCurrPos + 1 < pSourceTextEnd) && IsIdentifierChar(*(pCurrPos + 1))) // \note digits separator
+			{
+				pCurrPos += 2;
+				continue;
 			}
-			
-			return TToken{ E_TOKEN_TYPE::TT_IDENTIFIER, possibleIdentifier, { mCurrHorPosIndex, mCurrLineIndex } };
+
+			break;
 		}
 
-		// \note Try to recognize double character token first
-		if (_peekNextChar(1) != EOF)
+		_moveCursorTo(pCurrPos - 1); // \note Move to the last character of the number
+
+		return TToken{ E_TOKEN_TYPE::TT_NUMBER, mSourceText.substr(tokenStartPos, mCursor - tokenStartPos), static_cast<uint32_t>(tokenStartPos) };
+	}
+
+	std::optional<TToken> Lexer::_parseStringLiterals()
+	{
+		const size_t tokenStartPos = mCursor - 1;
+
+		const char* pSourceTextEnd = mSourceText.data() + mSourceText.size();
+		const char* pCurrPos = mSourceText.data() + tokenStartPos;
+
+		// \note Skip an encoding prefix (u8, u, U, L) and R one of raw strings
+		if (*pCurrPos == 'u' && (pCurrPos + 1 < pSourceTextEnd) && *(pCurrPos + 1) == '8')
 		{
-			possibleIdentifier.push_back(_peekNextChar(1));
-			auto&& iter = mReservedTokens.find(possibleIdentifier);
-			if (iter != mReservedTokens.cend())
-			{
-				if (iter->second != E_TOKEN_TYPE::TT_RIGHT_SHIFT || !mIsTemplateArgsParsingModeEnabled)
-				{
-					_getNextChar(); // eat previously peeked symbol
-					return TToken{ iter->second, iter->first, std::tuple<uint32_t, uint32_t>(mCurrHorPosIndex, mCurrLineIndex) };
-				}
-			}
+			pCurrPos += 2;
+		}
+		else if (*pCurrPos == 'u' || *pCurrPos == 'U' || *pCurrPos == 'L')
+		{
+			++pCurrPos;
+		}
 
-			possibleIdentifier.pop_back();
+		const bool isRawString = (pCurrPos < pSourceTextEnd) && (*pCurrPos == 'R');
+		if (isRawString)
+		{
+			++pCurrPos;
 		}
 
-		// \note try to detect symbol
-		auto&& iter = mReservedTokens.find(possibleIdentifier);
-		if (iter == mReservedTokens.cend())
+		if (pCurrPos >= pSourceTextEnd || (*pCurrPos != '"' && (isRawString || *pCurrPos != '\'')))
 		{
-			if (_getCurrChar() == EOF)
-			{
-				return TToken{ E_TOKEN_TYPE::TT_EOF, "", std::tuple<uint32_t, uint32_t>(mCurrHorPosIndex, mCurrLineIndex)};
-			}
+			return std::nullopt;
+		}
 
+		const char quote = *pCurrPos;
+
+		const char* pLiteralEnd = isRawString ? FindRawStringLiteralEnd(*mpScanners, pCurrPos + 1, pSourceTextEnd) : FindQuotedLiteralEnd(pCurrPos + 1, pSourceTextEnd, quote);
+		if (!pLiteralEnd)
+		{
 			return std::nullopt;
 		}
 
-		return TToken{ iter->second, iter->first, std::tuple<uint32_t, uint32_t>(mCurrHorPosIndex, mCurrLineIndex) };
+		_moveCursorTo(pLiteralEnd - 1); // \note Move to the last character of the literal
+
+		return TToken
+		{
+			(quote == '"') ? E_TOKEN_TYPE::TT_STRING_LITERAL : E_TOKEN_TYPE::TT_CHAR_LITERAL,
+			mSourceText.substr(tokenStartPos, mCursor - tokenStartPos),
+			static_cast<uint32_t>(tokenStartPos)
+		};
 	}
 
-	bool Lexer::_skipComments()
+	TToken Lexer::_parseReservedKeywordsAndIdentifiers()
 	{
-		if (_getCurrChar() != '/')
+		const size_t tokenStartPos = mCursor - 1;
+
+		const char* pSourceTextEnd = mSourceText.data() + mSourceText.size();
+		_moveCursorTo(mpScanners->mpFindIdentifierEnd(mSourceText.data() + mCursor, pSourceTextEnd) - 1); // \note Move to the last character of the identifier
+
+		const std::string_view identifier = mSourceText.substr(tokenStartPos, mCursor - tokenStartPos);
+
+		const E_TOKEN_TYPE tokenType = GetKeywordTokenType(identifier);
+		if (!mIsMetaTagParsingModeEnabled &&
+			(tokenType == E_TOKEN_TYPE::TT_SECTION_TAG_KEY ||
+			tokenType == E_TOKEN_TYPE::TT_NAME_TAG_KEY ||
+			tokenType == E_TOKEN_TYPE::TT_FLAGS_TAG_KEY ||
+			tokenType == E_TOKEN_TYPE::TT_SERIALIZE_ALL_FIELDS_FLAG ||
+			tokenType == E_TOKEN_TYPE::TT_SERIALIZE_MARKED_FIELDS_ONLY_FLAG))
 		{
-			return false;
+			return TToken{ E_TOKEN_TYPE::TT_IDENTIFIER, identifier, static_cast<uint32_t>(tokenStartPos) };
 		}
 
-		char ch = _peekNextChar(1);
+		return TToken{ tokenType, identifier, static_cast<uint32_t>(tokenStartPos) };
+	}
+
+	TToken Lexer::_parsePunctuators()
+	{
+		const size_t tokenStartPos = mCursor - 1;
 
-		if (std::isspace(ch))
+		// \note Try to recognize double character token first
+		if (_peekNextChar(1) != EOF)
+		{
+			const std::string_view punctuator = mSourceText.substr(tokenStartPos, 2);
+
+			const E_TOKEN_TYPE tokenType = GetPunctuatorTokenType(punctuator);
+			if (E_TOKEN_TYPE::TT_UNKNOWN != tokenType && (tokenType != E_TOKEN_TYPE::TT_RIGHT_SHIFT || !mIsTemplateArgsParsingModeEnabled))
+			{
+				_getNextChar(); // eat previously peeked symbol
+				return TToken{ tokenType, punctuator, static_cast<uint32_t>(tokenStartPos) };
+			}
+		}
+
+		// \note try to detect symbol, TT_UNKNOWN is returned for all unrecognized ones
+		const std::string_view punctuator = mSourceText.substr(tokenStartPos, 1);
+
+		return TToken{ GetPunctuatorTokenType(punctuator), punctuator, static_cast<uint32_t>(tokenStartPos) };
+	}
+
+	bool Lexer::_skipComments()
+	{
+		if (_getCurrChar() != '/')
 		{
-			// increment counter of lines
 			return false;
 		}
 
-		switch (ch)
+		switch (_peekNextChar(1))
 		{
 			case '/':
 				_getNextChar(); // take '/'
@@ -466,24 +1122,137 @@ namespace TDEngine2
 
 	void Lexer::_skipSingleLineComment()
 	{
-		char ch = ' ';
+		const char ch = _getNextChar();
+
+		if (ch != EOF && ch != '\n')
+		{
+			_moveCursorTo(mpScanners->mpFindLineEnd(mSourceText.data() + mCursor - 1, mSourceText.data() + mSourceText.size()));
+		}
+	}
+
+	bool Lexer::_skipLiteral()
+	{
+		const char* pTextBegin = mSourceText.data();
+		const char* pTextEnd = pTextBegin + mSourceText.size();
 
-		while ((ch = _getNextChar()) != EOF && ch != '\n') {}
+		const char* pQuote = pTextBegin + mCursor - 1;
 
-		// \todo increment counter of lines
+		if (*pQuote == '\'' && IsDigitsSeparator(pTextBegin, pQuote))
+		{
+			return false;
+		}
+
+		const char* pLiteralEnd = nullptr;
+
+		if (*pQuote == '"' && IsRawStringLiteralPrefix(pTextBegin, pQuote))
+		{
+			pLiteralEnd = FindRawStringLiteralEnd(*mpScanners, pQuote + 1, pTextEnd);
+		}
+
+		if (!pLiteralEnd)
+		{
+			pLiteralEnd = FindQuotedLiteralEnd(pQuote + 1, pTextEnd, *pQuote);
+		}
+
+		_moveCursorTo(pLiteralEnd - 1);
+
+		return true;
+	}
+
+	bool Lexer::_skipNonCodeText()
+	{
+		switch (_getCurrChar())
+		{
+			case '/':
+				return _skipComments();
+			case '#':
+				return _skipMacroDefinitions();
+			case '"':
+			case '\'':
+				return _skipLiteral();
+		}
+
+		return false;
+	}
+
+	char Lexer::_skipToBalancedTextDelimiter()
+	{
+		_fetchSourceText();
+
+		const char* pTextBegin = mSourceText.data();
+		const char* pTextEnd = pTextBegin + mSourceText.size();
+
+		while (mCursor < mSourceText.size())
+		{
+			const char* pCurrPos = mpScanners->mpFindBalancedTextDelimiter(pTextBegin + mCursor, pTextEnd);
+			if (pCurrPos == pTextEnd)
+			{
+				break;
+			}
+
+			_moveCursorTo(pCurrPos);
+
+			switch (*pCurrPos)
+			{
+				case '{':
+				case '}':
+				case '(':
+				case ')':
+					return *pCurrPos;
+				default:
+					_skipNonCodeText();
+					break;
+			}
+		}
+
+		_moveCursorTo(pTextEnd);
+
+		return EOF;
+	}
+
+	bool Lexer::_skipBalancedText(char openChar, char closeChar, uint32_t depth)
+	{
+		for (char ch = _skipToBalancedTextDelimiter(); ch != EOF; ch = _skipToBalancedTextDelimiter())
+		{
+			if (ch == openChar)
+			{
+				++depth;
+				continue;
+			}
+
+			if (ch == closeChar && !--depth)
+			{
+				return true;
+			}
+		}
+
+		return false;
 	}
 
 	void Lexer::_skipMultiLineComment()
 	{
 		char currCh = ' ';
-		char nextCh = ' ';
 
-		/*uint32_t x = mCurrPos;
-		uint32_t y = mCurrLine;*/
+		const char* pSourceTextEnd = mSourceText.data() + mSourceText.size();
 
-		while (((currCh = _getNextChar()) != EOF && currCh != '*') ||
-			(currCh == '*' && (nextCh = _peekNextChar(1)) != '/'))
+		while ((currCh = _getNextChar()) != EOF)
 		{
+			// \note Only '*' and '/' are meaningful within the comment, so jump over all other characters at once
+			if (currCh != '*' && currCh != '/')
+			{
+				_moveCursorTo(mpScanners->mpFindCommentDelimiter(mSourceText.data() + mCursor - 1, pSourceTextEnd));
+				
+				if ((currCh = _getCurrChar()) == EOF)
+				{
+					break;
+				}
+			}
+
+			if (currCh == '*' && _peekNextChar(1) == '/')
+			{
+				break;
+			}
+
 			_skipComments();
 		}
 
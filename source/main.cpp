@@ -1,12 +1,14 @@
 #include <iostream>
 #include <array>
+#include <algorithm>
 #include "../include/common.h"
 #include "../include/lexer.h"
 #include "../include/parser.h"
 #include "../include/symtable.h"
 #include "../include/codegenerator.h"
 #include "../include/jobmanager.h"
-#include "../deps/archive/archive.h"
+#include "../include/cachepack.h"
+#include "../include/symtableview.h"
 #include "../deps/Wrench/source/stringUtils.hpp"
 #include "../deps/Wrench/source/deferOperation.hpp"
 
@@ -71,8 +73,40 @@ int main(int argc, const char** argv)
 		cachedData.Reset();
 	}
 
+	const std::string outputFilename = fs::path(options.mOutputDirname + "/").concat(options.mOutputFilename).string();
+
+	auto isFileStampUpToDate = [&cachedData](const std::string& filename)
+	{
+		TSymTableCacheEntry cacheEntry;
+		TFileStamp fileStamp;
+
+		return cachedData.FindSymTableEntity(filename, cacheEntry) && GetFileStamp(filename, fileStamp) && (cacheEntry.mStamp == fileStamp);
+	};
+
+	THash128 runDigest {};
+	TFileStamp outputStamp;
+
+	// \note The stat pass, if neither headers nor options have changed since the last run and the output is intact there is nothing to do
+	if (!options.mIsForceModeEnabled && 
+		GetFileStamp(outputFilename, outputStamp) && (outputStamp == cachedData.GetLastOutputStamp()) &&
+		std::all_of(filesToProcess.cbegin(), filesToProcess.cend(), isFileStampUpToDate) &&
+		ComputeRunDigest(options, filesToProcess, cachedData, runDigest) && (runDigest == cachedData.GetLastRunDigest()))
+	{
+		WriteOutput("Nothing has changed since the last run... Exit\n");
+		return 0;
+	}
+
 	CodeGenerator::TSymbolTablesArray symbolsPerFile { filesToProcess.size() };
 
+	const std::string cachePackPath = fs::path(options.mCacheDirname).concat(options.mCachePackFilename).string();
+
+	CachePack cachePack;
+
+	if (options.mIsPackedCacheEnabled)
+	{
+		cachePack.Open(cachePackPath);
+	}
+
 	{
 		JobManager jobManager(options.mCurrNumOfThreads); // jobManager as a scoped object makes us possible to wait for all jobs will be done to the end of the scope
 
@@ -81,69 +115,114 @@ int main(int argc, const char** argv)
 		// \note Build symbol tables for each header file
 		for (size_t i = 0; i < filesToProcess.size(); ++i)
 		{
-			jobManager.SubmitJob(std::function<void()>([&filesToProcess, &symbolsPerFile, &cachedData, i, &options, cacheDirectory = options.mCacheDirname, isForceModeEnabled]
+			jobManager.SubmitJob(std::function<void()>([&filesToProcess, &symbolsPerFile, &cachedData, &cachePack, i, &options, cacheDirectory = options.mCacheDirname, isForceModeEnabled]
 			{
 				const std::string& filename = filesToProcess[i];
-				const std::string hash = GetHashFromFilePath(filename);
+
+				TSymTableCacheEntry cacheEntry;
+				const bool hasCacheEntry = cachedData.FindSymTableEntity(filename, cacheEntry);
+
+				TFileStamp fileStamp;
+				const bool hasFileStamp = GetFileStamp(filename, fileStamp);
+
+				// \note The content is read and hashed only if the file's size, modification time or inode differs from the cached ones
+				const bool isStampChanged = !hasCacheEntry || !hasFileStamp || (cacheEntry.mStamp != fileStamp);
+				const THash128 contentHash = isStampChanged ? GetHashFromFileContent(filename) : cacheEntry.mContentHash;
+
+				std::string hash = GetSymTableCacheFilename(filename, contentHash);
+
+				if (options.mIsTaggedOnlyModeEnabled)
+				{
+					hash.append("_tagged"); // \note Symbol tables that are built in tagged only mode are incomplete, so don't mix them up with full ones
+				}
 
 				const auto& cachePath = fs::path(cacheDirectory).concat(hash).string();
+				const THash128 packKey = ComputeHash128(hash);
 
-				if (cachedData.Contains(filename, hash) && !isForceModeEnabled)
+				if (hasCacheEntry && (cacheEntry.mContentHash == contentHash) && !isForceModeEnabled)
 				{
-					// \note If the specified file exists then reuse data inside it
-					std::ifstream symTableSourceFile(cachePath, std::ios::binary);
+					// \note If the specified file (or the pack's entry) exists then reuse data inside it in place
+					TSymTableSource& source = symbolsPerFile[i];
 
-					if (symTableSourceFile.is_open())
+					if (options.mIsPackedCacheEnabled)
 					{
-						WriteOutput(std::string("\n").append("Reuse cached version of ").append(filename).append(" file... "));
+						source.mView.Init(cachePack.Find(packKey));
+					}
+					else
+					{
+						auto pSymTableSourceFile = std::make_unique<MemoryMappedInputStream>(cachePath);
 
-						Archive<std::ifstream> symTableSourceArchive(symTableSourceFile);
+						if (pSymTableSourceFile->Open() && source.mView.Init(pSymTableSourceFile->GetContents()))
+						{
+							source.mpViewStorage = std::move(pSymTableSourceFile);
+						}
+					}
 
-						symbolsPerFile[i] = std::make_unique<SymTable>();
-						symbolsPerFile[i]->Load(symTableSourceArchive);
+					if (source.mView.IsValid())
+					{
+						WriteOutput(std::string("\n").append("Reuse cached version of ").append(filename).append(" file... "));
 
-						symTableSourceFile.close();
+						if (isStampChanged)
+						{
+							cachedData.AddSymTableEntity(filename, { fileStamp, contentHash }); // \note Refresh the stamp to skip hashing next time
+						}
 
 						return;
-					}					
+					}
 				}
 
-				symbolsPerFile[i] = std::move(ProcessHeaderFile(options, filename));
+				symbolsPerFile[i].mpSymTable = std::move(ProcessHeaderFile(options, filename));
 
 				// \note Serialize data
+				std::string symTableData = SymTableView::Build(*symbolsPerFile[i].mpSymTable);
+
+				if (options.mIsPackedCacheEnabled)
+				{
+					cachePack.Add(packKey, std::move(symTableData));
+				}
+				else
 				{
 					std::ofstream symTableOutputFile(cachePath, std::ios::binary);
-					Archive<std::ofstream> symTableOutputArchive(symTableOutputFile);
-
-					symbolsPerFile[i]->Save(symTableOutputArchive);
-
+					symTableOutputFile.write(symTableData.data(), symTableData.size());
 					symTableOutputFile.close();
-
-					cachedData.AddSymTableEntity(filename, hash);
 				}
+
+				cachedData.AddSymTableEntity(filename, { fileStamp, contentHash });
 			}));
 		}
 	}
 
-	// \note Generate meta-information as cpp files
-	CodeGenerator codeGenerator;
+	{
+		// \note Generate meta-information as cpp files, the output is completed when the generator is destroyed
+		CodeGenerator codeGenerator;
 
-	const std::string outputFilename = fs::path(options.mOutputDirname + "/").concat(options.mOutputFilename).string();
+		if (!codeGenerator.Init([](const std::string& filename) { return std::make_unique<FileOutputStream>(filename); }, 
+								outputFilename, options.mEmitFlags, options.mTypenamesPatternsToExclude, options.mIsTaggedOnlyModeEnabled,
+								options.mCurrNumOfThreads))
+		{
+			return -1;
+		}
 
-	if (!codeGenerator.Init([](const std::string& filename) { return std::make_unique<FileOutputStream>(filename); }, 
-							outputFilename, options.mEmitFlags, options.mTypenamesPatternsToExclude, options.mIsTaggedOnlyModeEnabled))
-	{
-		return -1;
+		if (!codeGenerator.Generate(std::move(symbolsPerFile)))
+		{
+			return -1;
+		}
 	}
 
-	if (!codeGenerator.Generate(std::move(symbolsPerFile)))
+	// \note Update cache if the feature isn't disabled
+	cachedData.SetInputHash(GetHashFromInputFiles(options.mInputSources));
+
+	if (ComputeRunDigest(options, filesToProcess, cachedData, runDigest) && GetFileStamp(outputFilename, outputStamp))
 	{
-		return -1;
+		cachedData.SetLastRunInfo(runDigest, outputStamp);
 	}
 
-	// \note Update cache if the feature isn't disabled
-	cachedData.SetInputHash(GetHashFromInputFiles(options.mInputSources));
 	cachedData.Save(options.mCacheDirname, options.mCacheIndexFilename);
 
+	if (options.mIsPackedCacheEnabled)
+	{
+		cachePack.Save(cachePackPath);
+	}
+
 	return 0;
 }
\ No newline at end of file
@@ -141,7 +141,7 @@ namespace TDEngine2
 					if (!isInvokedFromTemplateDecl)
 					{
 						// \note For now just consume all tokens until ; reached in case of forward declarations
-						if (classParsingResult.IsOk() && std::dynamic_pointer_cast<TClassType>(classParsingResult.Get())->mIsForwardDeclaration)
+						if (classParsingResult.IsOk() && dynamic_cast<TClassType*>(classParsingResult.Get())->mIsForwardDeclaration)
 						{
 							while (mpLexer->GetCurrToken().mType != E_TOKEN_TYPE::TT_SEMICOLON && mpLexer->GetCurrToken().mType != E_TOKEN_TYPE::TT_EOF)
 							{
@@ -258,7 +258,7 @@ namespace TDEngine2
 			return false;
 		}
 
-		std::string namespaceId = mpLexer->GetCurrToken().mValue;
+		const std::string namespaceId{ mpLexer->GetCurrToken().mValue };
 		if (!mpSymTable->CreateScope(namespaceId))
 		{
 			assert(false);
@@ -274,11 +274,11 @@ namespace TDEngine2
 
 		if (auto pNamespaceScope = mpSymTable->LookUpNamedScope(namespaceId))
 		{
-			if (auto pNamespaceType = std::make_unique<TNamespaceType>())
+			if (auto pNamespaceType = mpSymTable->CreateType<TNamespaceType>())
 			{
-				pNamespaceType->mId = namespaceId;
+				pNamespaceType->mId = InternString(namespaceId);
 
-				pNamespaceScope->mpType = std::move(pNamespaceType);
+				mpSymTable->SetScopeType(*pNamespaceScope, pNamespaceType);
 			}			
 		}
 
@@ -413,7 +413,7 @@ namespace TDEngine2
 			return false;
 		}
 
-		std::string enumName = mpLexer->GetCurrToken().mValue;
+		const std::string enumName{ mpLexer->GetCurrToken().mValue };
 
 		bool result = mpSymTable->CreateScope(enumName);
 		assert(result);
@@ -441,13 +441,12 @@ namespace TDEngine2
 
 		if (auto pEnumScopeEntity = mpSymTable->LookUpNamedScope(enumName))
 		{			
-			auto pEnumTypeDesc = std::make_unique<TEnumType>();
+			auto pEnumTypeDesc = mpSymTable->CreateType<TEnumType>();
 
-			pEnumTypeDesc->mId = enumName;
-			pEnumTypeDesc->mMangledId = mpSymTable->GetMangledNameForNamedScope(enumName);
+			pEnumTypeDesc->mId = InternString(enumName);
+			pEnumTypeDesc->mMangledId = pEnumScopeEntity->mMangledId;
 			pEnumTypeDesc->mIsStronglyTyped = isStronglyTypedEnum;
 			pEnumTypeDesc->mIsForwardDeclaration = (mpLexer->GetCurrToken().mType == E_TOKEN_TYPE::TT_SEMICOLON);
-			pEnumTypeDesc->mpOwner = mpSymTable;
 			pEnumTypeDesc->mpParentType = mpSymTable->GetCurrScopeType();
 			pEnumTypeDesc->mAccessModifier = accessModifier;
 			pEnumTypeDesc->mIsMarkedWithAttribute = isTagged;
@@ -457,7 +456,7 @@ namespace TDEngine2
 			{
 				mpLexer->GetNextToken(); // eat {
 
-				_parseEnumBody(pEnumTypeDesc.get());
+				_parseEnumBody(pEnumTypeDesc);
 
 				if (!_expect(E_TOKEN_TYPE::TT_CLOSE_BRACE, mpLexer->GetCurrToken()))
 				{
@@ -467,7 +466,7 @@ namespace TDEngine2
 				mpLexer->GetNextToken(); // eat }
 			}
 
-			pEnumScopeEntity->mpType = std::move(pEnumTypeDesc);
+			mpSymTable->SetScopeType(*pEnumScopeEntity, pEnumTypeDesc);
 		}
 
 		mpSymTable->ExitScope();
@@ -618,11 +617,10 @@ namespace TDEngine2
 			return false;
 		}
 
-		auto pClassTypeDesc = std::make_unique<TClassType>();
+		auto pClassTypeDesc = mpSymTable->CreateType<TClassType>();
 
-		pClassTypeDesc->mId                    = className;
-		pClassTypeDesc->mMangledId             = mpSymTable->GetMangledNameForNamedScope(className);
-		pClassTypeDesc->mpOwner                = mpSymTable;
+		pClassTypeDesc->mId                    = InternString(className);
+		pClassTypeDesc->mMangledId             = pClassScopeEntity->mMangledId;
 		pClassTypeDesc->mIsStruct              = isStruct;
 		pClassTypeDesc->mIsUnion               = isUnion;
 		pClassTypeDesc->mIsTemplate            = isTemplate;
@@ -638,9 +636,9 @@ namespace TDEngine2
 			mpLexer->GetNextToken();
 		}
 
-		defer([pClassScopeEntity, &pClassTypeDesc] 
+		defer([this, pClassScopeEntity, pClassTypeDesc] 
 		{
-			pClassScopeEntity->mpType = std::move(pClassTypeDesc);
+			mpSymTable->SetScopeType(*pClassScopeEntity, pClassTypeDesc);
 		});
 
 		if (E_TOKEN_TYPE::TT_COLON != mpLexer->GetCurrToken().mType)
@@ -690,8 +688,7 @@ namespace TDEngine2
 
 			// \note Parse base class's identifier 
 			// \todo Refactor this to correctly parse names, now it just eats tokens and assumes that it's correct name
-			std::string& baseClassId = info.mFullName;
-			baseClassId.append(_parseClassIdentifier());
+			info.mFullName = InternString(_parseClassIdentifier());
 
 			pClassTypeDesc->mBaseClasses.emplace_back(info);
 			
@@ -726,10 +723,10 @@ namespace TDEngine2
 
 		if (!pClassScopeEntity->mpType)
 		{
-			pClassScopeEntity->mpType = std::make_unique<TClassType>();
+			mpSymTable->SetScopeType(*pClassScopeEntity, mpSymTable->CreateType<TClassType>());
 		}
 
-		TClassType* pClassTypeDesc =  dynamic_cast<TClassType*>(pClassScopeEntity->mpType.get());
+		TClassType* pClassTypeDesc =  dynamic_cast<TClassType*>(pClassScopeEntity->mpType);
 		
 		// \note Try to parse body, it starts from {
 		if (E_TOKEN_TYPE::TT_OPEN_BRACE != mpLexer->GetCurrToken().mType)
@@ -941,7 +938,7 @@ namespace TDEngine2
 			return true;
 		}
 
-		std::shared_ptr<TClassType> pClassTypeDesc = std::dynamic_pointer_cast<TClassType>(mpSymTable->GetCurrScopeType());
+		TClassType* pClassTypeDesc = dynamic_cast<TClassType*>(mpSymTable->GetCurrScopeType());
 		assert(pClassTypeDesc);
 
 		while (mpLexer->GetCurrToken().mType != E_TOKEN_TYPE::TT_SEMICOLON)
@@ -955,7 +952,7 @@ namespace TDEngine2
 				HasEnumFlag(pClassTypeDesc->mAttributes.mFlags, E_SERIALIZATION_ATTRIBUTES_FLAGS::SERIALIZE_ALL) || 
 				(HasEnumFlag(pClassTypeDesc->mAttributes.mFlags, E_SERIALIZATION_ATTRIBUTES_FLAGS::SERIALIZE_MARKED_ONLY) && !currFieldInfo.mName.empty());
 
-			currFieldInfo.mOriginalName = mpLexer->GetCurrToken().mValue;
+			currFieldInfo.mOriginalName = InternString(mpLexer->GetCurrToken().mValue);
 
 			pClassTypeDesc->mFields.push_back(currFieldInfo);
 
@@ -1132,8 +1129,7 @@ namespace TDEngine2
 
 		if (E_TOKEN_TYPE::TT_IDENTIFIER == firstToken.mType || (E_TOKEN_TYPE::TT_COLON == firstToken.mType && E_TOKEN_TYPE::TT_COLON == mpLexer->PeekToken().mType)) // :: or identifier comes first
 		{
-			std::stringstream compoundIdentifier{};
-			compoundIdentifier << (E_TOKEN_TYPE::TT_IDENTIFIER == firstToken.mType ? firstToken.mValue : "::");
+			std::string compoundIdentifier{ E_TOKEN_TYPE::TT_IDENTIFIER == firstToken.mType ? firstToken.mValue : "::" };
 
 			mpLexer->GetNextToken();
 
@@ -1149,7 +1145,7 @@ namespace TDEngine2
 			while (ALLOWED_TOKEN_TYPES.find(mpLexer->GetCurrToken().mType) != ALLOWED_TOKEN_TYPES.cend() || (E_TOKEN_TYPE::TT_COLON == mpLexer->GetCurrToken().mType && E_TOKEN_TYPE::TT_COLON == mpLexer->PeekToken().mType)
 				|| templateArgsDepth > 0)
 			{
-				compoundIdentifier << mpLexer->GetCurrToken().mValue;
+				compoundIdentifier.append(mpLexer->GetCurrToken().mValue);
 
 				if (E_TOKEN_TYPE::TT_LESS == mpLexer->GetCurrToken().mType)
 				{
@@ -1164,13 +1160,13 @@ namespace TDEngine2
 
 				if (E_TOKEN_TYPE::TT_COLON == mpLexer->GetCurrToken().mType && E_TOKEN_TYPE::TT_COLON == mpLexer->PeekToken().mType)
 				{
-					compoundIdentifier << mpLexer->GetNextToken().mValue; // consume :: part
+					compoundIdentifier.append(mpLexer->GetNextToken().mValue); // consume :: part
 				}
 
 				mpLexer->GetNextToken();
 			}
 
-			return compoundIdentifier.str();
+			return compoundIdentifier;
 		}
 
 		defer([this] { mpLexer->SetTemplateArgsParsingMode(false); });
@@ -1203,6 +1199,18 @@ namespace TDEngine2
 			return true;
 		}
 
+		if (E_TOKEN_TYPE::TT_LESS != balancedTokenToCheck) // \note Braces and parentheses are skipped by the lexer without tokenization
+		{
+			if (!mpLexer->SkipBalancedTokens())
+			{
+				return false;
+			}
+
+			mpLexer->GetNextToken();
+
+			return true;
+		}
+
 		std::stack<TToken> matchedTokens { { BALANCED_TOKENS_TABLE.at(currToken.mType) }};
 
 		while (!matchedTokens.empty())
@@ -1248,7 +1256,7 @@ namespace TDEngine2
 		{
 			TParserError error;
 			error.mCode = TParserError::E_PARSER_ERROR_CODE::UNEXPECTED_SYMBOL;
-			error.mPos  = token.mPos;
+			error.mPos  = mpLexer->GetCursorPosition(token.mOffset);
 			error.mData.mUnexpectedTokenErrData = { token.mType, expectedType };
 
 			mOnErrorCallback(error);
@@ -0,0 +1,499 @@
+#include "../include/scanners.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define TDE2_SCANNERS_X86_ENABLED
+
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#include <immintrin.h>
+
+		#define TDE2_TARGET_SSE2
+		#define TDE2_TARGET_AVX2
+	#else
+		#include <immintrin.h>
+
+		#define TDE2_TARGET_SSE2 __attribute__((target("sse2")))
+		#define TDE2_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+
+namespace TDEngine2
+{
+	/*!
+		\brief Scalar kernels, they're used when there is no SIMD support and for tails of SIMD kernels
+	*/
+
+	static const char* SkipWhitespacesScalar(const char* pBegin, const char* pEnd)
+	{
+		while (pBegin < pEnd && IsWhitespace(*pBegin))
+		{
+			++pBegin;
+		}
+
+		return pBegin;
+	}
+
+	static const char* FindLineEndScalar(const char* pBegin, const char* pEnd)
+	{
+		while (pBegin < pEnd && *pBegin != '\n')
+		{
+			++pBegin;
+		}
+
+		return pBegin;
+	}
+
+	static const char* FindCommentDelimiterScalar(const char* pBegin, const char* pEnd)
+	{
+		while (pBegin < pEnd && *pBegin != '*' && *pBegin != '/')
+		{
+			++pBegin;
+		}
+
+		return pBegin;
+	}
+
+	static const char* FindIdentifierEndScalar(const char* pBegin, const char* pEnd)
+	{
+		while (pBegin < pEnd && IsIdentifierChar(*pBegin))
+		{
+			++pBegin;
+		}
+
+		return pBegin;
+	}
+
+	static inline bool IsBalancedTextDelimiter(char ch)
+	{
+		switch (ch)
+		{
+			case '{': case '}': case '(': case ')': case '/': case '#': case '"': case '\'':
+				return true;
+		}
+
+		return false;
+	}
+
+	static const char* FindBalancedTextDelimiterScalar(const char* pBegin, const char* pEnd)
+	{
+		while (pBegin < pEnd && !IsBalancedTextDelimiter(*pBegin))
+		{
+			++pBegin;
+		}
+
+		return pBegin;
+	}
+
+	static const char* FindSubstringScalar(const char* pBegin, const char* pEnd, const char* pPattern, size_t patternLength)
+	{
+		if (!patternLength)
+		{
+			return pBegin;
+		}
+
+		for (; pEnd - pBegin >= static_cast<ptrdiff_t>(patternLength); ++pBegin)
+		{
+			if (*pBegin == *pPattern && !std::memcmp(pBegin + 1, pPattern + 1, patternLength - 1))
+			{
+				return pBegin;
+			}
+		}
+
+		return pEnd;
+	}
+
+
+#if defined(TDE2_SCANNERS_X86_ENABLED)
+
+	static inline uint32_t CountTrailingZeros(uint32_t value)
+	{
+	#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanForward(&index, value);
+		return static_cast<uint32_t>(index);
+	#else
+		return static_cast<uint32_t>(__builtin_ctz(value));
+	#endif
+	}
+
+
+	/*!
+		SSE2 kernels, each iteration processes 16 characters
+	*/
+
+	TDE2_TARGET_SSE2 static inline __m128i IsInRangeSSE2(__m128i chars, char first, uint8_t length)
+	{
+		// \note (ch - first) <= length - 1 as unsigned comparison
+		const __m128i offsets = _mm_sub_epi8(chars, _mm_set1_epi8(first));
+		return _mm_cmpeq_epi8(_mm_min_epu8(offsets, _mm_set1_epi8(static_cast<char>(length - 1))), offsets);
+	}
+
+	TDE2_TARGET_SSE2 static const char* SkipWhitespacesSSE2(const char* pBegin, const char* pEnd)
+	{
+		for (; pEnd - pBegin >= 16; pBegin += 16)
+		{
+			const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBegin));
+
+			// \note '\t', '\n', '\v', '\f', '\r' are placed sequentially, so a single range check is enough for them
+			const __m128i whitespaces = _mm_or_si128(IsInRangeSSE2(chars, '\t', 5), _mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')));
+
+			if (const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(whitespaces)) & 0xFFFF)
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return SkipWhitespacesScalar(pBegin, pEnd);
+	}
+
+	TDE2_TARGET_SSE2 static const char* FindLineEndSSE2(const char* pBegin, const char* pEnd)
+	{
+		const __m128i newLines = _mm_set1_epi8('\n');
+
+		for (; pEnd - pBegin >= 16; pBegin += 16)
+		{
+			const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBegin));
+
+			if (const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, newLines))))
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return FindLineEndScalar(pBegin, pEnd);
+	}
+
+	TDE2_TARGET_SSE2 static const char* FindCommentDelimiterSSE2(const char* pBegin, const char* pEnd)
+	{
+		const __m128i stars = _mm_set1_epi8('*');
+		const __m128i slashes = _mm_set1_epi8('/');
+
+		for (; pEnd - pBegin >= 16; pBegin += 16)
+		{
+			const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBegin));
+			const __m128i delimiters = _mm_or_si128(_mm_cmpeq_epi8(chars, stars), _mm_cmpeq_epi8(chars, slashes));
+
+			if (const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(delimiters)))
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return FindCommentDelimiterScalar(pBegin, pEnd);
+	}
+
+	TDE2_TARGET_SSE2 static const char* FindIdentifierEndSSE2(const char* pBegin, const char* pEnd)
+	{
+		for (; pEnd - pBegin >= 16; pBegin += 16)
+		{
+			const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBegin));
+
+			const __m128i letters = IsInRangeSSE2(_mm_or_si128(chars, _mm_set1_epi8(0x20)), 'a', 26); // \note 0x20 bit converts upper case to lower one
+			const __m128i digits = IsInRangeSSE2(chars, '0', 10);
+			const __m128i identifierChars = _mm_or_si128(_mm_or_si128(letters, digits), _mm_cmpeq_epi8(chars, _mm_set1_epi8('_')));
+
+			if (const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(identifierChars)) & 0xFFFF)
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return FindIdentifierEndScalar(pBegin, pEnd);
+	}
+
+	TDE2_TARGET_SSE2 static const char* FindBalancedTextDelimiterSSE2(const char* pBegin, const char* pEnd)
+	{
+		for (; pEnd - pBegin >= 16; pBegin += 16)
+		{
+			const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBegin));
+
+			// \note '(' and ')' differ only in the lowest bit, so set it to check both characters at once
+			const __m128i braces = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('{')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('}')));
+			const __m128i parentheses = _mm_cmpeq_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x01)), _mm_set1_epi8(')'));
+			const __m128i quotes = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('"')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\'')));
+			const __m128i others = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('/')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('#')));
+
+			const __m128i delimiters = _mm_or_si128(_mm_or_si128(braces, parentheses), _mm_or_si128(quotes, others));
+
+			if (const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(delimiters)))
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return FindBalancedTextDelimiterScalar(pBegin, pEnd);
+	}
+
+	/*!
+		\brief The kernel compares the first and the last characters of the pattern against 16 positions at once and
+		checks the rest part of the pattern only for candidates
+	*/
+
+	TDE2_TARGET_SSE2 static const char* FindSubstringSSE2(const char* pBegin, const char* pEnd, const char* pPattern, size_t patternLength)
+	{
+		if (patternLength < 2)
+		{
+			return FindSubstringScalar(pBegin, pEnd, pPattern, patternLength);
+		}
+
+		const __m128i firstChars = _mm_set1_epi8(pPattern[0]);
+		const __m128i lastChars = _mm_set1_epi8(pPattern[patternLength - 1]);
+
+		for (; pEnd - pBegin >= static_cast<ptrdiff_t>(patternLength + 15); pBegin += 16)
+		{
+			const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBegin));
+			const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBegin + patternLength - 1));
+
+			uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstChars), _mm_cmpeq_epi8(blockLast, lastChars))));
+
+			while (mask)
+			{
+				const uint32_t offset = CountTrailingZeros(mask);
+
+				if (!std::memcmp(pBegin + offset + 1, pPattern + 1, patternLength - 2))
+				{
+					return pBegin + offset;
+				}
+
+				mask &= mask - 1;
+			}
+		}
+
+		return FindSubstringScalar(pBegin, pEnd, pPattern, patternLength);
+	}
+
+
+	/*!
+		AVX2 kernels, each iteration processes 32 characters
+	*/
+
+	TDE2_TARGET_AVX2 static inline __m256i IsInRangeAVX2(__m256i chars, char first, uint8_t length)
+	{
+		const __m256i offsets = _mm256_sub_epi8(chars, _mm256_set1_epi8(first));
+		return _mm256_cmpeq_epi8(_mm256_min_epu8(offsets, _mm256_set1_epi8(static_cast<char>(length - 1))), offsets);
+	}
+
+	TDE2_TARGET_AVX2 static const char* SkipWhitespacesAVX2(const char* pBegin, const char* pEnd)
+	{
+		for (; pEnd - pBegin >= 32; pBegin += 32)
+		{
+			const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBegin));
+
+			const __m256i whitespaces = _mm256_or_si256(IsInRangeAVX2(chars, '\t', 5), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' ')));
+
+			if (const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(whitespaces)))
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return SkipWhitespacesScalar(pBegin, pEnd);
+	}
+
+	TDE2_TARGET_AVX2 static const char* FindLineEndAVX2(const char* pBegin, const char* pEnd)
+	{
+		const __m256i newLines = _mm256_set1_epi8('\n');
+
+		for (; pEnd - pBegin >= 32; pBegin += 32)
+		{
+			const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBegin));
+
+			if (const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, newLines))))
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return FindLineEndScalar(pBegin, pEnd);
+	}
+
+	TDE2_TARGET_AVX2 static const char* FindCommentDelimiterAVX2(const char* pBegin, const char* pEnd)
+	{
+		const __m256i stars = _mm256_set1_epi8('*');
+		const __m256i slashes = _mm256_set1_epi8('/');
+
+		for (; pEnd - pBegin >= 32; pBegin += 32)
+		{
+			const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBegin));
+			const __m256i delimiters = _mm256_or_si256(_mm256_cmpeq_epi8(chars, stars), _mm256_cmpeq_epi8(chars, slashes));
+
+			if (const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(delimiters)))
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return FindCommentDelimiterScalar(pBegin, pEnd);
+	}
+
+	TDE2_TARGET_AVX2 static const char* FindIdentifierEndAVX2(const char* pBegin, const char* pEnd)
+	{
+		for (; pEnd - pBegin >= 32; pBegin += 32)
+		{
+			const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBegin));
+
+			const __m256i letters = IsInRangeAVX2(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), 'a', 26);
+			const __m256i digits = IsInRangeAVX2(chars, '0', 10);
+			const __m256i identifierChars = _mm256_or_si256(_mm256_or_si256(letters, digits), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_')));
+
+			if (const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(identifierChars)))
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return FindIdentifierEndScalar(pBegin, pEnd);
+	}
+
+	TDE2_TARGET_AVX2 static const char* FindBalancedTextDelimiterAVX2(const char* pBegin, const char* pEnd)
+	{
+		for (; pEnd - pBegin >= 32; pBegin += 32)
+		{
+			const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBegin));
+
+			const __m256i braces = _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('}')));
+			const __m256i parentheses = _mm256_cmpeq_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x01)), _mm256_set1_epi8(')'));
+			const __m256i quotes = _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\'')));
+			const __m256i others = _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('/')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('#')));
+
+			const __m256i delimiters = _mm256_or_si256(_mm256_or_si256(braces, parentheses), _mm256_or_si256(quotes, others));
+
+			if (const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(delimiters)))
+			{
+				return pBegin + CountTrailingZeros(mask);
+			}
+		}
+
+		return FindBalancedTextDelimiterScalar(pBegin, pEnd);
+	}
+
+	TDE2_TARGET_AVX2 static const char* FindSubstringAVX2(const char* pBegin, const char* pEnd, const char* pPattern, size_t patternLength)
+	{
+		if (patternLength < 2)
+		{
+			return FindSubstringScalar(pBegin, pEnd, pPattern, patternLength);
+		}
+
+		const __m256i firstChars = _mm256_set1_epi8(pPattern[0]);
+		const __m256i lastChars = _mm256_set1_epi8(pPattern[patternLength - 1]);
+
+		for (; pEnd - pBegin >= static_cast<ptrdiff_t>(patternLength + 31); pBegin += 32)
+		{
+			const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBegin));
+			const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBegin + patternLength - 1));
+
+			uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, firstChars), _mm256_cmpeq_epi8(blockLast, lastChars))));
+
+			while (mask)
+			{
+				const uint32_t offset = CountTrailingZeros(mask);
+
+				if (!std::memcmp(pBegin + offset + 1, pPattern + 1, patternLength - 2))
+				{
+					return pBegin + offset;
+				}
+
+				mask &= mask - 1;
+			}
+		}
+
+		return FindSubstringScalar(pBegin, pEnd, pPattern, patternLength);
+	}
+
+#endif
+
+
+	static E_SIMD_INSTRUCTIONS_SET DetectSupportedInstructionsSet()
+	{
+#if defined(TDE2_SCANNERS_X86_ENABLED)
+	#if defined(_MSC_VER)
+		int cpuInfo[4];
+
+		__cpuid(cpuInfo, 0);
+		const int maxLeafIndex = cpuInfo[0];
+
+		__cpuid(cpuInfo, 1);
+
+		const bool hasSSE2 = (cpuInfo[3] & (1 << 26)) != 0;
+		const bool hasOSXSave = (cpuInfo[2] & (1 << 27)) != 0;
+		const bool hasAVX = (cpuInfo[2] & (1 << 28)) != 0;
+
+		bool hasAVX2 = false;
+
+		// \note AVX2 also requires OS support of YMM registers
+		if (maxLeafIndex >= 7 && hasOSXSave && hasAVX && ((_xgetbv(0) & 0x6) == 0x6))
+		{
+			__cpuidex(cpuInfo, 7, 0);
+			hasAVX2 = (cpuInfo[1] & (1 << 5)) != 0;
+		}
+	#else
+		__builtin_cpu_init();
+
+		const bool hasSSE2 = __builtin_cpu_supports("sse2");
+		const bool hasAVX2 = __builtin_cpu_supports("avx2");
+	#endif
+
+		if (hasAVX2)
+		{
+			return E_SIMD_INSTRUCTIONS_SET::AVX2;
+		}
+
+		if (hasSSE2)
+		{
+			return E_SIMD_INSTRUCTIONS_SET::SSE2;
+		}
+#endif
+
+		return E_SIMD_INSTRUCTIONS_SET::NONE;
+	}
+
+
+	E_SIMD_INSTRUCTIONS_SET GetSupportedInstructionsSet()
+	{
+		static const E_SIMD_INSTRUCTIONS_SET supportedInstructionsSet = DetectSupportedInstructionsSet();
+		return supportedInstructionsSet;
+	}
+
+	const TTextScannersTable& GetTextScanners(E_SIMD_INSTRUCTIONS_SET instructionsSet)
+	{
+		static const TTextScannersTable scalarScanners
+		{
+			&SkipWhitespacesScalar, &FindLineEndScalar, &FindCommentDelimiterScalar, &FindIdentifierEndScalar, &FindBalancedTextDelimiterScalar, &FindSubstringScalar, E_SIMD_INSTRUCTIONS_SET::NONE
+		};
+
+#if defined(TDE2_SCANNERS_X86_ENABLED)
+		static const TTextScannersTable sse2Scanners
+		{
+			&SkipWhitespacesSSE2, &FindLineEndSSE2, &FindCommentDelimiterSSE2, &FindIdentifierEndSSE2, &FindBalancedTextDelimiterSSE2, &FindSubstringSSE2, E_SIMD_INSTRUCTIONS_SET::SSE2
+		};
+
+		static const TTextScannersTable avx2Scanners
+		{
+			&SkipWhitespacesAVX2, &FindLineEndAVX2, &FindCommentDelimiterAVX2, &FindIdentifierEndAVX2, &FindBalancedTextDelimiterAVX2, &FindSubstringAVX2, E_SIMD_INSTRUCTIONS_SET::AVX2
+		};
+
+		const E_SIMD_INSTRUCTIONS_SET supportedInstructionsSet = GetSupportedInstructionsSet();
+
+		// \note Never return kernels that the host CPU can't execute
+		if (E_SIMD_INSTRUCTIONS_SET::AVX2 == instructionsSet && E_SIMD_INSTRUCTIONS_SET::AVX2 == supportedInstructionsSet)
+		{
+			return avx2Scanners;
+		}
+
+		if (E_SIMD_INSTRUCTIONS_SET::NONE != instructionsSet && E_SIMD_INSTRUCTIONS_SET::NONE != supportedInstructionsSet)
+		{
+			return sse2Scanners;
+		}
+#endif
+
+		return scalarScanners;
+	}
+
+	const TTextScannersTable& GetTextScanners()
+	{
+		static const TTextScannersTable& scanners = GetTextScanners(GetSupportedInstructionsSet());
+		return scanners;
+	}
+}
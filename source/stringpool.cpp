@@ -0,0 +1,128 @@
+#include "../include/stringpool.h"
+#include <mutex>
+#include <cassert>
+
+
+namespace TDEngine2
+{
+	std::string_view TAtom::GetString() const
+	{
+		return StringPool::Get().GetString(*this);
+	}
+
+	std::string TAtom::ToString() const
+	{
+		return std::string(GetString());
+	}
+
+	bool operator== (TAtom atom, std::string_view str)
+	{
+		return atom.GetString() == str;
+	}
+
+	bool operator!= (TAtom atom, std::string_view str)
+	{
+		return atom.GetString() != str;
+	}
+
+
+	StringPool& StringPool::Get()
+	{
+		static StringPool instance;
+		return instance;
+	}
+
+	/*!
+		\note An atom's value consists of a shard's index in the lowest bits and an index of the string within the shard increased by one
+	*/
+
+	TAtom StringPool::Intern(std::string_view str)
+	{
+		if (str.empty())
+		{
+			return TAtom{};
+		}
+
+		const size_t hash = std::hash<std::string_view>{}(str);
+		const uint32_t shardIndex = static_cast<uint32_t>(hash >> 7) & (mShardsCount - 1);
+
+		TShard& shard = mShards[shardIndex];
+
+		{
+			std::shared_lock<std::shared_mutex> lock(shard.mMutex);
+
+			auto it = shard.mStringsTable.find(str);
+			if (it != shard.mStringsTable.cend())
+			{
+				return TAtom{ it->second };
+			}
+		}
+
+		std::unique_lock<std::shared_mutex> lock(shard.mMutex);
+
+		auto it = shard.mStringsTable.find(str); // \note The string could be added by another thread while the lock was released
+		if (it != shard.mStringsTable.cend())
+		{
+			return TAtom{ it->second };
+		}
+
+		const std::string_view storedStr = shard.mArena.CreateString(str);
+		const uint32_t atomValue = ((static_cast<uint32_t>(shard.mStrings.size()) + 1) << mShardsCountLog2) | shardIndex;
+
+		shard.mStrings.push_back(storedStr);
+		shard.mStringsTable.emplace(storedStr, atomValue);
+
+		return TAtom{ atomValue };
+	}
+
+	TAtom StringPool::Find(std::string_view str) const
+	{
+		if (str.empty())
+		{
+			return TAtom{};
+		}
+
+		const size_t hash = std::hash<std::string_view>{}(str);
+		const TShard& shard = mShards[static_cast<uint32_t>(hash >> 7) & (mShardsCount - 1)];
+
+		std::shared_lock<std::shared_mutex> lock(shard.mMutex);
+
+		auto it = shard.mStringsTable.find(str);
+		return (it != shard.mStringsTable.cend()) ? TAtom{ it->second } : TAtom{};
+	}
+
+	std::string_view StringPool::GetString(TAtom atom) const
+	{
+		if (atom.IsEmpty())
+		{
+			return std::string_view();
+		}
+
+		const TShard& shard = mShards[atom.mValue & (mShardsCount - 1)];
+		const uint32_t stringIndex = (atom.mValue >> mShardsCountLog2) - 1;
+
+		std::shared_lock<std::shared_mutex> lock(shard.mMutex);
+
+		assert(stringIndex < shard.mStrings.size());
+		return shard.mStrings[stringIndex];
+	}
+
+	size_t StringPool::GetSize() const
+	{
+		size_t size = 0;
+
+		for (const TShard& currShard : mShards)
+		{
+			std::shared_lock<std::shared_mutex> lock(currShard.mMutex);
+			size += currShard.mStrings.size();
+		}
+
+		return size;
+	}
+
+
+	TAtom InternString(std::string_view str)
+	{
+		return StringPool::Get().Intern(str);
+	}
+}
@@ -1,12 +1,13 @@
 #include "../include/symtable.h"
-#include "../deps/archive/archive.h"
+#include "../include/symtableview.h"
+#include "../include/bufferarchive.h"
 #include <algorithm>
 #include <cassert>
 
 
 namespace TDEngine2
 {
-	bool TType::SafeSerialize(FileWriterArchive& archive, TType* pType)
+	bool TType::SafeSerialize(BufferWriterArchive& archive, TType* pType)
 	{
 		if (!pType)
 		{
@@ -17,26 +18,26 @@ namespace TDEngine2
 		return pType->Save(archive);
 	}
 
-	std::unique_ptr<TType> TType::Deserialize(FileReaderArchive& archive, SymTable* pSymTable)
+	TType* TType::Deserialize(BufferReaderArchive& archive, SymTable& symTable)
 	{
 		uint32_t subtypeValue = 0;
 		archive >> subtypeValue;
 
-		std::unique_ptr<TType> pType = nullptr;
+		TType* pType = nullptr;
 
 		switch (static_cast<TType::E_SUBTYPE>(subtypeValue))
 		{
 			case TType::E_SUBTYPE::BASE:
-				pType = std::make_unique<TType>();
+				pType = symTable.CreateType<TType>();
 				break;
 			case TType::E_SUBTYPE::ENUM:
-				pType = std::make_unique<TEnumType>();
+				pType = symTable.CreateType<TEnumType>();
 				break;
 			case TType::E_SUBTYPE::CLASS:
-				pType = std::make_unique<TClassType>();
+				pType = symTable.CreateType<TClassType>();
 				break;
 			case TType::E_SUBTYPE::NAMESPACE:
-				pType = std::make_unique<TNamespaceType>();
+				pType = symTable.CreateType<TNamespaceType>();
 				break;
 			case TType::E_SUBTYPE::UNKNOWN:
 				break;
@@ -48,21 +49,25 @@ namespace TDEngine2
 		}
 
 		pType->Load(archive);
-		pType->mpOwner = pSymTable;
 
 		return pType;
 	}
 
-	bool TType::Load(FileReaderArchive& archive)
+	bool TType::Load(BufferReaderArchive& archive)
 	{
-		archive >> mId >> mMangledId;
-		return true;
+		std::string id, mangledId;
+		archive >> id >> mangledId;
+
+		mId = InternString(id);
+		mMangledId = InternString(mangledId);
+
+		return !archive.HasFailed();
 	}
 
-	bool TType::Save(FileWriterArchive& archive)
+	bool TType::Save(BufferWriterArchive& archive)
 	{
 		archive << static_cast<uint32_t>(GetSubtype());
-		archive << mId << mMangledId;
+		archive << mId.ToString() << mMangledId.ToString();
 
 		return true;
 	}
@@ -77,7 +82,7 @@ namespace TDEngine2
 		visitor.VisitNamespaceType(*this);
 	}
 
-	bool TEnumType::Load(FileReaderArchive& archive)
+	bool TEnumType::Load(BufferReaderArchive& archive)
 	{
 		bool result = TType::Load(archive);
 
@@ -87,6 +92,11 @@ namespace TDEngine2
 		uint32_t enumeratorsCount = 0;
 		archive >> enumeratorsCount;
 
+		if (enumeratorsCount > archive.GetRemainingSize()) // \note Each enumerator takes one byte at least
+		{
+			return false;
+		}
+
 		std::string currEnumeratorValue;
 
 		for (size_t i = 0; i < enumeratorsCount; ++i)
@@ -95,10 +105,10 @@ namespace TDEngine2
 			mEnumerators.push_back(currEnumeratorValue);
 		}
 
-		return result;
+		return result && !archive.HasFailed();
 	}
 
-	bool TEnumType::Save(FileWriterArchive& archive)
+	bool TEnumType::Save(BufferWriterArchive& archive)
 	{
 		bool result = TType::Save(archive);
 
@@ -120,7 +130,7 @@ namespace TDEngine2
 		visitor.VisitEnumType(*this);
 	}
 
-	bool TClassType::Load(FileReaderArchive& archive)
+	bool TClassType::Load(BufferReaderArchive& archive)
 	{
 		bool result = TType::Load(archive);
 
@@ -129,6 +139,11 @@ namespace TDEngine2
 		size_t baseClassesCount = 0;
 		archive >> baseClassesCount;
 
+		if (baseClassesCount > archive.GetRemainingSize())
+		{
+			return false;
+		}
+
 		std::string fullNameStr;
 		bool isVirtualInherited;
 		uint32_t accessSpecifier;
@@ -139,13 +154,13 @@ namespace TDEngine2
 			archive >> isVirtualInherited;
 			archive >> accessSpecifier;
 
-			mBaseClasses.push_back({ fullNameStr, isVirtualInherited, static_cast<E_ACCESS_SPECIFIER_TYPE>(accessSpecifier) });
+			mBaseClasses.push_back({ InternString(fullNameStr), isVirtualInherited, static_cast<E_ACCESS_SPECIFIER_TYPE>(accessSpecifier) });
 		}
 
-		return result;
+		return result && !archive.HasFailed();
 	}
 
-	bool TClassType::Save(FileWriterArchive& archive)
+	bool TClassType::Save(BufferWriterArchive& archive)
 	{
 		bool result = TType::Save(archive);
 
@@ -155,7 +170,7 @@ namespace TDEngine2
 
 		for (auto&& baseClassEntity : mBaseClasses)
 		{
-			archive << baseClassEntity.mFullName;
+			archive << baseClassEntity.mFullName.ToString();
 			archive << baseClassEntity.mIsVirtualInherited;
 			archive << static_cast<uint32_t>(baseClassEntity.mAccessSpecifier);
 		}
@@ -182,44 +197,113 @@ namespace TDEngine2
 	}
 
 
-	SymTable::SymTable():
-		mpGlobalScope(new TScopeEntity), mpCurrScope(mpGlobalScope.get()), mpPrevScope(nullptr)
+	SymTable::SymTable()
 	{
-		mpGlobalScope->mpParentScope = nullptr;
+		_reset();
 	}
 
 	SymTable::~SymTable()
 	{
 	}
 
-	bool SymTable::TScopeEntity::Save(FileWriterArchive& archive)
+	static uint32_t GetSymbolNameHash(std::string_view name)
 	{
-		archive << mpNestedScopes.size();
+		const size_t hash = std::hash<std::string_view>{}(name);
+		return static_cast<uint32_t>(hash ^ (static_cast<uint64_t>(hash) >> 32));
+	}
+
+	const TSymbolDesc* SymTable::TScopeEntity::FindSymbol(std::string_view name) const
+	{
+		const int32_t symbolIndex = _findSymbolIndex(name);
+		return (symbolIndex < 0) ? nullptr : &mVariables[symbolIndex];
+	}
+
+	void SymTable::TScopeEntity::UpsertSymbol(TSymbolDesc&& desc)
+	{
+		const int32_t symbolIndex = _findSymbolIndex(desc.mName);
+		if (symbolIndex >= 0) // \note there is already symbol with the same name than update it
+		{
+			mVariables[symbolIndex].mpType = desc.mpType;
+			return;
+		}
+
+		mVariables.emplace_back(std::forward<TSymbolDesc>(desc)); // \note The index will be updated by the next lookup
+	}
+
+	int32_t SymTable::TScopeEntity::_findSymbolIndex(std::string_view name) const
+	{
+		if (mVariables.size() <= mSymbolsIndexThreshold)
+		{
+			auto&& iter = std::find_if(mVariables.cbegin(), mVariables.cend(), [name](const TSymbolDesc& entity) { return name == entity.mName; });
+			return (iter == mVariables.cend()) ? -1 : static_cast<int32_t>(std::distance(mVariables.cbegin(), iter));
+		}
+
+		_updateSymbolsIndex();
+
+		const uint32_t hash = GetSymbolNameHash(name);
+		const size_t mask = mSymbolsIndex.size() - 1;
 
-		for (auto&& pCurrScope : mpNestedScopes)
+		for (size_t slotIndex = hash & mask; mSymbolsIndex[slotIndex]; slotIndex = (slotIndex + 1) & mask)
 		{
-			if (!pCurrScope)
+			const uint64_t slot = mSymbolsIndex[slotIndex];
+			const uint32_t symbolIndex = static_cast<uint32_t>(slot) - 1;
+
+			if (static_cast<uint32_t>(slot >> 32) == hash && mVariables[symbolIndex].mName == name)
 			{
-				continue; 
+				return static_cast<int32_t>(symbolIndex);
 			}
-
-			pCurrScope->Save(archive);
 		}
 
-		archive << mpNamedScopes.size();
+		return -1;
+	}
 
-		for (auto&& currScopeEntity : mpNamedScopes)
+	void SymTable::TScopeEntity::_updateSymbolsIndex() const
+	{
+		const uint32_t symbolsCount = static_cast<uint32_t>(mVariables.size());
+		if (mIndexedSymbolsCount == symbolsCount)
 		{
-			archive << currScopeEntity.first;
+			return;
+		}
 
-			if (!currScopeEntity.second)
+		// \note Keep the load factor not greater than 0.5, the table is rebuilt from scratch when it grows
+		if (2 * static_cast<size_t>(symbolsCount) > mSymbolsIndex.size())
+		{
+			size_t capacity = 2 * mSymbolsIndexThreshold;
+			while (capacity < 2 * static_cast<size_t>(symbolsCount))
 			{
-				continue;
+				capacity <<= 1;
 			}
 
-			currScopeEntity.second->Save(archive);
+			mSymbolsIndex.assign(capacity, 0);
+			mIndexedSymbolsCount = 0;
 		}
 
+		for (uint32_t i = mIndexedSymbolsCount; i < symbolsCount; ++i)
+		{
+			_insertIntoSymbolsIndex(i, GetSymbolNameHash(mVariables[i].mName));
+		}
+
+		mIndexedSymbolsCount = symbolsCount;
+	}
+
+	void SymTable::TScopeEntity::_insertIntoSymbolsIndex(uint32_t symbolIndex, uint32_t hash) const
+	{
+		const size_t mask = mSymbolsIndex.size() - 1;
+
+		size_t slotIndex = hash & mask;
+		while (mSymbolsIndex[slotIndex])
+		{
+			slotIndex = (slotIndex + 1) & mask;
+		}
+
+		mSymbolsIndex[slotIndex] = (static_cast<uint64_t>(hash) << 32) | (static_cast<uint64_t>(symbolIndex) + 1);
+	}
+
+	bool SymTable::TScopeEntity::Save(BufferWriterArchive& archive) const
+	{
+		archive << mName.ToString();
+		archive << mParentIndex;
+
 		// \note Save variables
 		archive << mVariables.size();
 
@@ -227,54 +311,39 @@ namespace TDEngine2
 		{
 			archive << currVariableInfo.mName;
 			
-			TType::SafeSerialize(archive, currVariableInfo.mpType.get());
+			TType::SafeSerialize(archive, currVariableInfo.mpType);
 		}
 
-		archive << (mIndex >= 0 ? mIndex : (std::numeric_limits<int>::max)());
+		archive << mIndex; // \note Negative indices are zigzag-encoded, so -1 takes a single byte
 
-		TType::SafeSerialize(archive, mpType.get());
+		TType::SafeSerialize(archive, mpType);
 
 		return true;
 	}
 
-	bool SymTable::TScopeEntity::Load(FileReaderArchive& archive, SymTable* symTable)
+	bool SymTable::TScopeEntity::Load(BufferReaderArchive& archive, SymTable& symTable)
 	{
-		size_t nestedScopesCount = 0;
-		archive >> nestedScopesCount;
-
-		for (size_t i = 0; i < nestedScopesCount; ++i)
-		{
-			mpNestedScopes.emplace_back(std::make_unique<TScopeEntity>());
-
-			auto pCurrScope = mpNestedScopes.back().get();
-
-			pCurrScope->Load(archive, symTable);
-			pCurrScope->mpParentScope = this;
-		}
-
-		size_t namedScopesCount = 0;
-		archive >> namedScopesCount;
-
 		std::string scopeName;
+		archive >> scopeName;
 
-		for (size_t i = 0; i < namedScopesCount; ++i)
-		{
-			archive >> scopeName;
+		mName = InternString(scopeName);
 
-			mpNamedScopes.emplace(scopeName, std::make_unique<TScopeEntity>());
-			
-			auto pCurrScope = mpNamedScopes[scopeName].get();
+		archive >> mParentIndex;
 
-			pCurrScope->Load(archive, symTable);
-			pCurrScope->mpParentScope = this;
-		}
-
-		// \note Save variables
+		// \note Load variables
 		size_t variablesCount = 0;
 		archive >> variablesCount;
 
+		if (variablesCount > archive.GetRemainingSize())
+		{
+			return false;
+		}
+
 		mVariables.resize(variablesCount);
 
+		mSymbolsIndex.clear();
+		mIndexedSymbolsCount = 0;
+
 		std::string variableId;
 
 		for (size_t i = 0; i < variablesCount; ++i)
@@ -282,75 +351,102 @@ namespace TDEngine2
 			archive >> variableId;
 
 			mVariables[i].mName = variableId;
-			mVariables[i].mpType = std::move(TType::Deserialize(archive, symTable));
+			mVariables[i].mpType = TType::Deserialize(archive, symTable);
 		}
 
 		archive >> mIndex;
 
-		mIndex = (mIndex == (std::numeric_limits<int>::max)()) ? -1 : mIndex;
+		mpType = TType::Deserialize(archive, symTable);
 
-		mpType = std::move(TType::Deserialize(archive, symTable));
-
-		return true;
+		return !archive.HasFailed();
 	}
 
-	bool SymTable::Save(FileWriterArchive& archive)
+	bool SymTable::Save(BufferWriterArchive& archive)
 	{
-		bool result = mpGlobalScope->Save(archive);
+		archive << mScopes.size();
+
+		for (const TScopeEntity& currScope : mScopes)
+		{
+			if (!currScope.Save(archive))
+			{
+				return false;
+			}
+		}
 
 		archive << mSourceFilename;
 
-		return result;
+		return true;
 	}
 
-	bool SymTable::Load(FileReaderArchive& archive)
+	bool SymTable::Load(BufferReaderArchive& archive)
 	{
 		_reset();
 
-		mpGlobalScope = std::make_unique<TScopeEntity>();
-		mpCurrScope = mpGlobalScope.get();
+		size_t scopesCount = 0;
+		archive >> scopesCount;
+
+		if (!scopesCount || scopesCount > archive.GetRemainingSize())
+		{
+			return false;
+		}
+
+		mScopes.resize(scopesCount);
 
-		bool result = mpGlobalScope->Load(archive, this);
+		for (uint32_t i = 0; i < static_cast<uint32_t>(scopesCount); ++i)
+		{
+			TScopeEntity& currScope = mScopes[i];
+
+			if (!currScope.Load(archive, *this))
+			{
+				return false;
+			}
+
+			if (!i)
+			{
+				continue; // \note The global scope has no parent
+			}
+
+			if (currScope.mParentIndex >= i) // \note Parents are always created before their children
+			{
+				return false;
+			}
+
+			_linkScope(i);
+		}
 
 		archive >> mSourceFilename;
 
-		return result;
+		return !archive.HasFailed();
 	}
 
 	void SymTable::Visit(ISymTableVisitor& visitor)
 	{
-		visitor.VisitScope(*mpGlobalScope);
+		for (const TScopeEntity& currScope : mScopes)
+		{
+			if (currScope.IsNamed())
+			{
+				visitor.VisitNamedScope(currScope);
+				continue;
+			}
+
+			visitor.VisitScope(currScope);
+		}
 	}
 
 	void SymTable::AddSymbol(TSymbolDesc&& desc)
 	{
-		assert(mpCurrScope);
-
-		auto& symbols = mpCurrScope->mVariables;
-
-		auto iter = std::find_if(symbols.begin(), symbols.end(), [&desc](const TSymbolDesc& entity) { return desc.mName == entity.mName; });
-		if (iter != symbols.end()) // \note there is already symbol with the same name than update it
-		{
-			iter->mpType = std::move(desc.mpType);
-			return;
-		}
-
-		symbols.emplace_back(std::forward<TSymbolDesc>(desc));
+		mScopes[mCurrScopeIndex].UpsertSymbol(std::forward<TSymbolDesc>(desc));
 	}
 
 	bool SymTable::CreateScope(const std::string& name)
 	{
-		assert(mpCurrScope);
-
 		mIsReadOnlyMode = false;
 
-		return name.empty() ? _createAnonymousScope() : _createNamedScope(name);
+		return _createScope(InternString(name));
 	}
 
 	bool SymTable::EnterScope(const std::string& name)
 	{
-		assert(mpCurrScope);
-
 		mIsReadOnlyMode = true;
 
 		return name.empty() ? _visitAnonymousScope() : _visitNamedScope(name);
@@ -358,14 +454,17 @@ namespace TDEngine2
 
 	void SymTable::ExitScope()
 	{
-		int32_t currScopeIndex = mpCurrScope->mIndex;
+		const TScopeEntity& currScope = mScopes[mCurrScopeIndex];
+
+		int32_t currScopeIndex = currScope.mIndex;
 
 		bool isUnnamedScope = currScopeIndex >= 0;
 
-		mpCurrScope = mpCurrScope->mpParentScope;
+		assert(currScope.mParentIndex != TScopeEntity::mInvalidIndex);
+		mCurrScopeIndex = currScope.mParentIndex;
 
 		// \note move to next neighbour scope if we currently stay in unnamed one and there is this next neighbour
-		if (mIsReadOnlyMode && isUnnamedScope && (mpCurrScope->mpNestedScopes.size() > currScopeIndex))
+		if (mIsReadOnlyMode && isUnnamedScope && (mScopes[mCurrScopeIndex].mAnonymousScopesCount > static_cast<uint32_t>(currScopeIndex)))
 		{
 			mLastVisitedScopeIndex = currScopeIndex;
 		}
@@ -383,67 +482,30 @@ namespace TDEngine2
 		return _lookUpInternal(id);
 	}
 
-	SymTable::TScopeEntity* SymTable::LookUpNamedScope(const std::string& name)
+	SymTable::TScopeEntity* SymTable::LookUpNamedScope(const std::string& id)
 	{
-		auto findScope = [name](TScopeEntity* pScope) -> TScopeEntity*
+		const TAtom name = StringPool::Get().Find(id); // \note An unknown string can't be a name of any scope
+		if (name.IsEmpty())
 		{
-			auto&& namedScopes = pScope->mpNamedScopes;
-
-			auto&& iter = namedScopes.find(name);
-			if (iter == namedScopes.cend())
-			{
-				return nullptr;
-			}
-
-			return (iter->second).get();
-		};
-		
-		if (TScopeEntity* pResult = findScope(mpCurrScope))
-		{
-			return pResult;
+			return nullptr;
 		}
-		
-		TScopeEntity* pCurrScope = mpCurrScope;
-		while (pCurrScope->mpParentScope)
-		{
-			pCurrScope = pCurrScope->mpParentScope;
 
-			if (TScopeEntity* pResult = findScope(pCurrScope))
+		for (uint32_t currScopeIndex = mCurrScopeIndex; currScopeIndex != TScopeEntity::mInvalidIndex; currScopeIndex = mScopes[currScopeIndex].mParentIndex)
+		{
+			const uint32_t namedScopeIndex = _findNamedScope(currScopeIndex, name);
+			if (namedScopeIndex != TScopeEntity::mInvalidIndex)
 			{
-				return pResult;
+				return &mScopes[namedScopeIndex];
 			}
 		}
 
 		return nullptr;
 	}
 
-	std::string SymTable::GetMangledNameForNamedScope(const std::string& id)
+	TAtom SymTable::GetMangledNameForNamedScope(const std::string& id)
 	{
 		TScopeEntity* pNamedScope = LookUpNamedScope(id);
-		if (!pNamedScope)
-		{
-			return "";
-		}
-
-		std::string mangledId = id;
-
-		TScopeEntity* pCurrScope = pNamedScope;
-		while (pCurrScope->mpParentScope)
-		{
-			pCurrScope = pCurrScope->mpParentScope;
-
-			if (pCurrScope->mIndex != -1 || !pCurrScope->mpType) // \note only named scopes influences onto the result id
-			{
-				continue;
-			}
-
-			if (auto pType = pCurrScope->mpType.get())
-			{
-				mangledId = pType->mId + "@" + mangledId;
-			}
-		}
-
-		return mangledId;
+		return pNamedScope ? pNamedScope->mMangledId : TAtom{};
 	}
 
 	void SymTable::SetSourceFilename(const std::string& filename)
@@ -456,23 +518,61 @@ namespace TDEngine2
 		return mSourceFilename;
 	}
 
-	TType::Ptr SymTable::GetCurrScopeType() const
+	TType* SymTable::GetCurrScopeType() const
 	{
-		return mpCurrScope->mpType;
+		return mScopes[mCurrScopeIndex].mpType;
 	}
 
-	TType::Ptr SymTable::GetParentScopeType() const
+	TType* SymTable::GetParentScopeType() const
 	{
-		auto pParentScope = mpCurrScope->mpParentScope;
+		const uint32_t parentIndex = mScopes[mCurrScopeIndex].mParentIndex;
 
-		return pParentScope ? pParentScope->mpType : nullptr;
+		return (parentIndex != TScopeEntity::mInvalidIndex) ? mScopes[parentIndex].mpType : nullptr;
+	}
+
+	void SymTable::SetScopeType(TScopeEntity& scope, TType* pType)
+	{
+		assert(&scope >= mScopes.data() && &scope < mScopes.data() + mScopes.size());
+
+		const TType::E_SUBTYPE prevSubtype = scope.mpType ? scope.mpType->GetSubtype() : TType::E_SUBTYPE::UNKNOWN;
+		scope.mpType = pType;
+
+		_registerTypedScope(static_cast<uint32_t>(&scope - mScopes.data()), prevSubtype);
+	}
+
+	const std::vector<uint32_t>& SymTable::GetTypedScopes(TType::E_SUBTYPE subtype) const
+	{
+		static const std::vector<uint32_t> emptyList;
+		return (subtype < TType::E_SUBTYPE::UNKNOWN) ? mTypedScopesPerKind[static_cast<size_t>(subtype)] : emptyList;
+	}
+
+	const SymTable::TScopeEntity& SymTable::GetScope(uint32_t index) const
+	{
+		assert(index < mScopes.size());
+		return mScopes[index];
+	}
+
+	size_t SymTable::GetScopesCount() const
+	{
+		return mScopes.size();
 	}
 
 	void SymTable::_reset()
 	{
-		mpGlobalScope = nullptr;
-		mpCurrScope = nullptr;
-		mpPrevScope = nullptr;
+		mArena.Reset(); /// \note All types and names are released at once
+
+		mScopes.clear();
+		mScopes.emplace_back(); // \note The global scope
+
+		mNamedScopesTable.clear();
+
+		for (auto&& currTypedScopes : mTypedScopesPerKind)
+		{
+			currTypedScopes.clear();
+		}
+
+		mCurrScopeIndex = 0;
+		mPrevScopeIndex = 0;
 
 		mIsReadOnlyMode = false;
 
@@ -482,105 +582,132 @@ namespace TDEngine2
 		mSourceFilename = "";
 	}
 
-	bool SymTable::_createAnonymousScope()
+	bool SymTable::_createScope(TAtom name)
 	{
-		int32_t nextScopeIndex = static_cast<int32_t>(mpCurrScope->mpNestedScopes.size());
+		if (!name.IsEmpty() && _findNamedScope(mCurrScopeIndex, name) != TScopeEntity::mInvalidIndex)
+		{
+			return false;
+		}
 
-		mpCurrScope->mpNestedScopes.emplace_back(std::make_unique<TScopeEntity>());
+		const uint32_t scopeIndex = static_cast<uint32_t>(mScopes.size());
 
-		TScopeEntity* pNewScope = mpCurrScope->mpNestedScopes.back().get();
-		
-		pNewScope->mpParentScope = mpCurrScope;
-		pNewScope->mIndex        = nextScopeIndex;
+		TScopeEntity& newScope = mScopes.emplace_back();
+
+		newScope.mName        = name;
+		newScope.mParentIndex = mCurrScopeIndex;
+		newScope.mIndex       = name.IsEmpty() ? static_cast<int32_t>(mScopes[mCurrScopeIndex].mAnonymousScopesCount) : -1;
+
+		_linkScope(scopeIndex);
 
-		mpCurrScope = pNewScope;
+		mCurrScopeIndex = scopeIndex;
 
 		return true;
 	}
 
-	bool SymTable::_createNamedScope(const std::string& name)
+	void SymTable::_linkScope(uint32_t scopeIndex)
 	{
-		if (mpCurrScope->mpNamedScopes.find(name) != mpCurrScope->mpNamedScopes.cend())
+		TScopeEntity& scope = mScopes[scopeIndex];
+		TScopeEntity& parentScope = mScopes[scope.mParentIndex];
+
+		scope.mMangledId = parentScope.mMangledId; // \note Anonymous scopes don't influence onto mangled ids
+
+		if (scope.IsNamed())
 		{
-			return false;
+			scope.mMangledId = parentScope.mMangledId.IsEmpty() ? scope.mName : InternString(parentScope.mMangledId.ToString().append("@").append(scope.mName.GetString()));
 		}
 
-		mpCurrScope->mpNamedScopes.emplace(name, std::make_unique<TScopeEntity>());
+		if (TScopeEntity::mInvalidIndex == parentScope.mLastChildIndex)
+		{
+			parentScope.mFirstChildIndex = scopeIndex;
+		}
+		else
+		{
+			mScopes[parentScope.mLastChildIndex].mNextSiblingIndex = scopeIndex;
+		}
 
-		TScopeEntity* pNewScope = mpCurrScope->mpNamedScopes[name].get();
+		parentScope.mLastChildIndex = scopeIndex;
 
-		pNewScope->mpParentScope = mpCurrScope;
-		pNewScope->mIndex        = -1;
+		_registerTypedScope(scopeIndex, TType::E_SUBTYPE::UNKNOWN); // \note Loaded scopes already have their types
 
-		mpCurrScope = pNewScope;
+		if (scope.IsNamed())
+		{
+			mNamedScopesTable.emplace(_getNamedScopeKey(scope.mParentIndex, scope.mName), scopeIndex);
+			return;
+		}
 
-		return true;
+		++parentScope.mAnonymousScopesCount;
+	}
+
+	void SymTable::_registerTypedScope(uint32_t scopeIndex, TType::E_SUBTYPE prevSubtype)
+	{
+		const TType* pType = mScopes[scopeIndex].mpType;
+		if (!pType || pType->GetSubtype() == prevSubtype || pType->GetSubtype() >= TType::E_SUBTYPE::UNKNOWN)
+		{
+			return; // \note The scope is already registered within the list of the kind
+		}
+
+		mTypedScopesPerKind[static_cast<size_t>(pType->GetSubtype())].push_back(scopeIndex);
 	}
 
 	bool SymTable::_visitAnonymousScope()
 	{
-		mpPrevScope = mpCurrScope;
-		mpCurrScope = mpCurrScope->mpNestedScopes[mLastVisitedScopeIndex + 1].get();
+		const uint32_t nextAnonymousScopeIndex = static_cast<uint32_t>(mLastVisitedScopeIndex + 1);
 
-		mLastVisitedScopeIndex = -1;
+		for (uint32_t currScopeIndex = mScopes[mCurrScopeIndex].mFirstChildIndex; currScopeIndex != TScopeEntity::mInvalidIndex; currScopeIndex = mScopes[currScopeIndex].mNextSiblingIndex)
+		{
+			const TScopeEntity& currScope = mScopes[currScopeIndex];
 
-		return true;
+			if (currScope.IsNamed() || static_cast<uint32_t>(currScope.mIndex) != nextAnonymousScopeIndex)
+			{
+				continue;
+			}
+
+			mPrevScopeIndex = mCurrScopeIndex;
+			mCurrScopeIndex = currScopeIndex;
+
+			mLastVisitedScopeIndex = -1;
+
+			return true;
+		}
+
+		return false;
 	}
 
 	bool SymTable::_visitNamedScope(const std::string& name)
 	{
-		mpPrevScope = mpCurrScope;
+		mPrevScopeIndex = mCurrScopeIndex;
 		
-		if (mpCurrScope->mIndex >= 0)
+		if (mScopes[mCurrScopeIndex].mIndex >= 0)
 		{
 			mPrevVisitedScopeIndex = mLastVisitedScopeIndex;
 		}
 
-		auto&& namedScopes = mpCurrScope->mpNamedScopes;
-
-		auto&& iter = namedScopes.find(name);
-		if (iter == namedScopes.cend())
+		const uint32_t namedScopeIndex = _findNamedScope(mCurrScopeIndex, StringPool::Get().Find(name));
+		if (namedScopeIndex == TScopeEntity::mInvalidIndex)
 		{
 			return false;
 		}
 
-		mpCurrScope = (iter->second).get();
+		mCurrScopeIndex = namedScopeIndex;
 
 		mLastVisitedScopeIndex = -1;
 
 		return true;
 	}
 
-	const TSymbolDesc& SymTable::_lookUpInternal(const std::string& id) const
+	uint32_t SymTable::_findNamedScope(uint32_t parentIndex, TAtom name) const
 	{
-		auto lookUp = [id](TScopeEntity* pScope) -> const TSymbolDesc*
-		{
-			auto&& symbols = pScope->mVariables;
-
-			auto&& iter = std::find_if(symbols.begin(), symbols.end(), [id](const TSymbolDesc& entity) { return id == entity.mName; });
-
-			if (iter != symbols.cend())
-			{
-				return &(*iter);
-			}
-
-			return nullptr;
-		};
-		
-		if (auto pResult = lookUp(mpCurrScope))
-		{
-			return *pResult;
-		}
-
-		TScopeEntity* pCurrScope = mpCurrScope;
+		auto&& iter = mNamedScopesTable.find(_getNamedScopeKey(parentIndex, name));
+		return (iter == mNamedScopesTable.cend()) ? TScopeEntity::mInvalidIndex : iter->second;
+	}
 
-		while (pCurrScope->mpParentScope)
+	const TSymbolDesc& SymTable::_lookUpInternal(const std::string& id) const
+	{
+		for (uint32_t currScopeIndex = mCurrScopeIndex; currScopeIndex != TScopeEntity::mInvalidIndex; currScopeIndex = mScopes[currScopeIndex].mParentIndex)
 		{
-			pCurrScope = pCurrScope->mpParentScope;
-
-			if (auto pResult = lookUp(pCurrScope))
+			if (const TSymbolDesc* pSymbol = mScopes[currScopeIndex].FindSymbol(id))
 			{
-				return *pResult;
+				return *pSymbol;
 			}
 		}
 
@@ -597,39 +724,37 @@ namespace TDEngine2
 	{
 	}
 
-	void EnumsMetaExtractor::VisitEnumType(const TEnumType& type)
+	void EnumsMetaExtractor::Extract(const SymTableView& view, SymTable& typesOwner)
 	{
-		if ((mEmitFlags & E_EMIT_FLAGS::ENUMS) != E_EMIT_FLAGS::ENUMS || 
-			E_ACCESS_SPECIFIER_TYPE::PUBLIC != type.mAccessModifier)
+		for (auto&& currRecord : view.GetEnums())
 		{
-			return;
-		}
-
-		if (auto pParentType = std::dynamic_pointer_cast<TClassType>(type.mpParentType.lock()))
-		{
-			if (pParentType->mIsTemplate)
+			if (_shouldExtract(static_cast<E_ACCESS_SPECIFIER_TYPE>(currRecord.mType.mAccessModifier), currRecord.mType.HasFlag(SymTableView::HAS_TEMPLATE_PARENT)))
 			{
-				return;
+				_addType(*view.CreateEnumType(currRecord, typesOwner));
 			}
 		}
+	}
 
-		auto iter = mTypesHashTable.find(type.mMangledId);
-		if (iter != mTypesHashTable.cend())
-		{
-			if (const TEnumType* pOtherEnum = mpTypesInfo[iter->second])
-			{
-				if (!pOtherEnum->mEnumerators.empty()) // \note we can update the enum's meta if it was declared previously not defined
-				{
-					return;
-				}
-
-				mpTypesInfo[iter->second] = &type;
-			}
+	void EnumsMetaExtractor::VisitEnumType(const TEnumType& type)
+	{
+		auto pParentType = dynamic_cast<const TClassType*>(type.mpParentType);
 
-			return;
+		if (_shouldExtract(type.mAccessModifier, pParentType && pParentType->mIsTemplate))
+		{
+			_addType(type);
 		}
+	}
 
-		mpTypesInfo.push_back(&type);
+	bool EnumsMetaExtractor::ShouldReplace(const TEnumType& currType, const TEnumType& candidateType) const
+	{
+		return currType.mEnumerators.empty(); // \note we can update the enum's meta if it was declared previously not defined
+	}
+
+	bool EnumsMetaExtractor::_shouldExtract(E_ACCESS_SPECIFIER_TYPE accessModifier, bool hasTemplateParent) const
+	{
+		return (mEmitFlags & E_EMIT_FLAGS::ENUMS) == E_EMIT_FLAGS::ENUMS &&
+				E_ACCESS_SPECIFIER_TYPE::PUBLIC == accessModifier &&
+				!hasTemplateParent;
 	}
 
 
@@ -642,35 +767,48 @@ namespace TDEngine2
 	{
 	}
 
-	void ClassMetaExtractor::VisitClassType(const TClassType& type)
+	void ClassMetaExtractor::Extract(const SymTableView& view, SymTable& typesOwner)
 	{
-		if ((!type.mIsStruct && ((mEmitFlags & E_EMIT_FLAGS::CLASSES) != E_EMIT_FLAGS::CLASSES)) || 
-			(type.mIsStruct && ((mEmitFlags & E_EMIT_FLAGS::STRUCTS) != E_EMIT_FLAGS::STRUCTS)) ||
-			(E_ACCESS_SPECIFIER_TYPE::PUBLIC != type.mAccessModifier) ||									/// skip either protected type
-			type.mIsTemplate)
+		for (auto&& currRecord : view.GetClasses())
 		{
-			return;
-		}
+			const SymTableView::TTypeRecord& typeRecord = currRecord.mType;
 
-		if (TType::Ptr typePtr = type.mpParentType.lock()) /// or a type that is part of another hidden type
-		{
-			if (E_ACCESS_SPECIFIER_TYPE::PUBLIC != typePtr->mAccessModifier)
+			const bool hasNonPublicParent = typeRecord.HasFlag(SymTableView::HAS_PARENT) &&
+											E_ACCESS_SPECIFIER_TYPE::PUBLIC != static_cast<E_ACCESS_SPECIFIER_TYPE>(typeRecord.mParentAccessModifier);
+
+			if (_shouldExtract(typeRecord.HasFlag(SymTableView::STRUCT), typeRecord.HasFlag(SymTableView::TEMPLATE), 
+							   static_cast<E_ACCESS_SPECIFIER_TYPE>(typeRecord.mAccessModifier), hasNonPublicParent))
 			{
-				return;
+				_addType(*view.CreateClassType(currRecord, typesOwner));
 			}
 		}
+	}
+
+	void ClassMetaExtractor::VisitClassType(const TClassType& type)
+	{
+		const bool hasNonPublicParent = type.mpParentType && (E_ACCESS_SPECIFIER_TYPE::PUBLIC != type.mpParentType->mAccessModifier);
 
-		auto iter = mTypesHashTable.find(type.mMangledId);
-		if (iter != mTypesHashTable.cend())
+		if (_shouldExtract(type.mIsStruct, type.mIsTemplate, type.mAccessModifier, hasNonPublicParent))
 		{
-			if (const TClassType* pOtherClass = mpTypesInfo[iter->second])
-			{				
-				mpTypesInfo[iter->second] = &type;
-			}
+			_addType(type);
+		}
+	}
 
-			return;
+	bool ClassMetaExtractor::ShouldReplace(const TClassType& currType, const TClassType& candidateType) const
+	{
+		return !candidateType.mIsForwardDeclaration || currType.mIsForwardDeclaration; // \note a forward declaration never hides a definition
+	}
+
+	bool ClassMetaExtractor::_shouldExtract(bool isStruct, bool isTemplate, E_ACCESS_SPECIFIER_TYPE accessModifier, bool hasNonPublicParent) const
+	{
+		if ((!isStruct && ((mEmitFlags & E_EMIT_FLAGS::CLASSES) != E_EMIT_FLAGS::CLASSES)) || 
+			(isStruct && ((mEmitFlags & E_EMIT_FLAGS::STRUCTS) != E_EMIT_FLAGS::STRUCTS)) ||
+			(E_ACCESS_SPECIFIER_TYPE::PUBLIC != accessModifier) ||										/// skip either protected type
+			isTemplate)
+		{
+			return false;
 		}
 
-		mpTypesInfo.push_back(&type);
+		return !hasNonPublicParent; /// or a type that is part of another hidden type
 	}
 }
\ No newline at end of file
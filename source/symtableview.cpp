@@ -0,0 +1,344 @@
+#include "../include/symtableview.h"
+#include <unordered_map>
+#include <vector>
+#include <cstring>
+
+
+namespace TDEngine2
+{
+	static_assert(sizeof(SymTableView::TTypeRecord) == 32, "TTypeRecord shouldn't contain implicit paddings");
+	static_assert(sizeof(SymTableView::TBaseClassRecord) == 12, "TBaseClassRecord shouldn't contain implicit paddings");
+	static_assert(sizeof(SymTableView::TFieldRecord) == 20, "TFieldRecord shouldn't contain implicit paddings");
+
+
+	std::string SymTableView::Build(const SymTable& symTable)
+	{
+		std::vector<TEnumRecord> enums;
+		std::vector<TClassRecord> classes;
+		std::vector<TStringRef> enumerators;
+		std::vector<TBaseClassRecord> baseClasses;
+		std::vector<TFieldRecord> fields;
+
+		std::string strings;
+		std::unordered_map<std::string_view, TStringRef> stringsTable; // \note Keys point into the table's data that outlives the method
+
+		auto addString = [&strings, &stringsTable](std::string_view str) -> TStringRef
+		{
+			if (str.empty())
+			{
+				return { 0, 0 };
+			}
+
+			auto iter = stringsTable.find(str);
+			if (iter != stringsTable.cend())
+			{
+				return iter->second;
+			}
+
+			const TStringRef ref { static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(str.size()) };
+
+			strings.append(str);
+			stringsTable.emplace(str, ref);
+
+			return ref;
+		};
+
+		auto createTypeRecord = [&addString](const TType& type, uint32_t flags) -> TTypeRecord
+		{
+			TTypeRecord record {};
+
+			record.mId = addString(type.mId.GetString());
+			record.mMangledId = addString(type.mMangledId.GetString());
+			record.mSectionId = addString(type.mAttributes.mSectionId);
+			record.mAccessModifier = static_cast<uint8_t>(type.mAccessModifier);
+			record.mSerializationFlags = static_cast<uint8_t>(type.mAttributes.mFlags);
+
+			flags |= type.mIsMarkedWithAttribute ? MARKED_WITH_ATTRIBUTE : 0;
+
+			if (const TType* pParentType = type.mpParentType)
+			{
+				flags |= HAS_PARENT;
+				record.mParentAccessModifier = static_cast<uint8_t>(pParentType->mAccessModifier);
+
+				if (auto pParentClass = dynamic_cast<const TClassType*>(pParentType))
+				{
+					flags |= pParentClass->mIsTemplate ? HAS_TEMPLATE_PARENT : 0;
+				}
+			}
+
+			record.mFlags = flags;
+
+			return record;
+		};
+
+		/// \note Take types in the same order as extractors do
+		for (const uint32_t currScopeIndex : symTable.GetTypedScopes(TType::E_SUBTYPE::ENUM))
+		{
+			auto pEnumType = dynamic_cast<const TEnumType*>(symTable.GetScope(currScopeIndex).mpType);
+			if (!pEnumType)
+			{
+				continue;
+			}
+
+			const uint32_t flags = (pEnumType->mIsStronglyTyped ? STRONGLY_TYPED : 0) |
+								   (pEnumType->mIsIntrospectable ? INTROSPECTABLE : 0) |
+								   (pEnumType->mIsForwardDeclaration ? FORWARD_DECLARATION : 0);
+
+			TEnumRecord record {};
+
+			record.mType = createTypeRecord(*pEnumType, flags);
+			record.mUnderlyingType = addString(pEnumType->mUnderlyingTypeStr);
+			record.mEnumerators = { static_cast<uint32_t>(enumerators.size()), static_cast<uint32_t>(pEnumType->mEnumerators.size()) };
+
+			for (const std::string& currEnumerator : pEnumType->mEnumerators)
+			{
+				enumerators.push_back(addString(currEnumerator));
+			}
+
+			enums.push_back(record);
+		}
+
+		for (const uint32_t currScopeIndex : symTable.GetTypedScopes(TType::E_SUBTYPE::CLASS))
+		{
+			auto pClassType = dynamic_cast<const TClassType*>(symTable.GetScope(currScopeIndex).mpType);
+			if (!pClassType)
+			{
+				continue;
+			}
+
+			const uint32_t flags = (pClassType->mIsFinal ? FINAL : 0) |
+								   (pClassType->mIsStruct ? STRUCT : 0) |
+								   (pClassType->mIsUnion ? UNION : 0) |
+								   (pClassType->mIsForwardDeclaration ? FORWARD_DECLARATION : 0) |
+								   (pClassType->mIsTemplate ? TEMPLATE : 0);
+
+			TClassRecord record {};
+
+			record.mType = createTypeRecord(*pClassType, flags);
+			record.mBaseClasses = { static_cast<uint32_t>(baseClasses.size()), static_cast<uint32_t>(pClassType->mBaseClasses.size()) };
+			record.mFields = { static_cast<uint32_t>(fields.size()), static_cast<uint32_t>(pClassType->mFields.size()) };
+
+			for (auto&& currBaseClass : pClassType->mBaseClasses)
+			{
+				TBaseClassRecord baseClassRecord {};
+
+				baseClassRecord.mFullName = addString(currBaseClass.mFullName.GetString());
+				baseClassRecord.mAccessSpecifier = static_cast<uint8_t>(currBaseClass.mAccessSpecifier);
+				baseClassRecord.mIsVirtualInherited = currBaseClass.mIsVirtualInherited;
+
+				baseClasses.push_back(baseClassRecord);
+			}
+
+			for (auto&& currField : pClassType->mFields)
+			{
+				fields.push_back({ addString(currField.mName), addString(currField.mOriginalName.GetString()), currField.mIsSerializable });
+			}
+
+			classes.push_back(record);
+		}
+
+		THeader header {};
+
+		std::string data(sizeof(THeader), '\0');
+
+		auto appendArray = [&data](const auto& records) -> TArrayRef
+		{
+			const TArrayRef ref { static_cast<uint32_t>(data.size()), static_cast<uint32_t>(records.size()) };
+			data.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(records[0]));
+
+			return ref;
+		};
+
+		header.mMagic = mMagic;
+		header.mVersion = mFormatVersion;
+
+		const std::string& sourceFilename = symTable.GetSourceFilename();
+
+		header.mEnums = appendArray(enums);
+		header.mClasses = appendArray(classes);
+		header.mEnumerators = appendArray(enumerators);
+		header.mBaseClasses = appendArray(baseClasses);
+		header.mFields = appendArray(fields);
+		header.mSourceFilename = addString(sourceFilename);
+		header.mStrings = { static_cast<uint32_t>(data.size()), static_cast<uint32_t>(strings.size()) };
+
+		data.append(strings);
+		data.resize((data.size() + 7) & ~static_cast<size_t>(7), '\0'); // \note Keep the size aligned, so views could be packed one after another
+
+		header.mSize = static_cast<uint32_t>(data.size());
+
+		std::memcpy(&data[0], &header, sizeof(THeader));
+
+		return data;
+	}
+
+	bool SymTableView::Init(std::string_view data)
+	{
+		mData = std::string_view();
+		mpHeader = nullptr;
+
+		if (data.size() < sizeof(THeader) || (reinterpret_cast<uintptr_t>(data.data()) % alignof(THeader)))
+		{
+			return false;
+		}
+
+		const THeader* pHeader = reinterpret_cast<const THeader*>(data.data());
+
+		if (pHeader->mMagic != mMagic || pHeader->mVersion != mFormatVersion || pHeader->mSize != data.size())
+		{
+			return false;
+		}
+
+		auto isArrayValid = [&data](const TArrayRef& arrayRef, size_t elementSize)
+		{
+			return !(arrayRef.mOffset % alignof(TStringRef)) && (arrayRef.mOffset <= data.size()) &&
+					(arrayRef.mCount <= (data.size() - arrayRef.mOffset) / elementSize);
+		};
+
+		if (!isArrayValid(pHeader->mEnums, sizeof(TEnumRecord)) ||
+			!isArrayValid(pHeader->mClasses, sizeof(TClassRecord)) ||
+			!isArrayValid(pHeader->mEnumerators, sizeof(TStringRef)) ||
+			!isArrayValid(pHeader->mBaseClasses, sizeof(TBaseClassRecord)) ||
+			!isArrayValid(pHeader->mFields, sizeof(TFieldRecord)) ||
+			!isArrayValid(pHeader->mStrings, 1))
+		{
+			return false;
+		}
+
+		mData = data;
+		mpHeader = pHeader;
+
+		return true;
+	}
+
+	std::string_view SymTableView::GetString(const TStringRef& ref) const
+	{
+		if (!mpHeader)
+		{
+			return std::string_view();
+		}
+
+		const TArrayRef& stringsRef = mpHeader->mStrings;
+
+		if (ref.mOffset > stringsRef.mCount || ref.mSize > stringsRef.mCount - ref.mOffset)
+		{
+			return std::string_view();
+		}
+
+		return mData.substr(static_cast<size_t>(stringsRef.mOffset) + ref.mOffset, ref.mSize);
+	}
+
+	std::string_view SymTableView::GetSourceFilename() const
+	{
+		return mpHeader ? GetString(mpHeader->mSourceFilename) : std::string_view();
+	}
+
+	SymTableView::TRecordsRange<SymTableView::TEnumRecord> SymTableView::GetEnums() const
+	{
+		return mpHeader ? _getRecords<TEnumRecord>(mpHeader->mEnums) : TRecordsRange<TEnumRecord>{};
+	}
+
+	SymTableView::TRecordsRange<SymTableView::TClassRecord> SymTableView::GetClasses() const
+	{
+		return mpHeader ? _getRecords<TClassRecord>(mpHeader->mClasses) : TRecordsRange<TClassRecord>{};
+	}
+
+	SymTableView::TRecordsRange<SymTableView::TStringRef> SymTableView::GetEnumerators(const TEnumRecord& enumRecord) const
+	{
+		return mpHeader ? _getSubrange<TStringRef>(mpHeader->mEnumerators, enumRecord.mEnumerators) : TRecordsRange<TStringRef>{};
+	}
+
+	SymTableView::TRecordsRange<SymTableView::TBaseClassRecord> SymTableView::GetBaseClasses(const TClassRecord& classRecord) const
+	{
+		return mpHeader ? _getSubrange<TBaseClassRecord>(mpHeader->mBaseClasses, classRecord.mBaseClasses) : TRecordsRange<TBaseClassRecord>{};
+	}
+
+	SymTableView::TRecordsRange<SymTableView::TFieldRecord> SymTableView::GetFields(const TClassRecord& classRecord) const
+	{
+		return mpHeader ? _getSubrange<TFieldRecord>(mpHeader->mFields, classRecord.mFields) : TRecordsRange<TFieldRecord>{};
+	}
+
+	TEnumType* SymTableView::CreateEnumType(const TEnumRecord& enumRecord, SymTable& symTable) const
+	{
+		TEnumType* pEnumType = symTable.CreateType<TEnumType>();
+		_fillType(enumRecord.mType, *pEnumType);
+
+		pEnumType->mIsStronglyTyped = enumRecord.mType.HasFlag(STRONGLY_TYPED);
+		pEnumType->mIsIntrospectable = enumRecord.mType.HasFlag(INTROSPECTABLE);
+		pEnumType->mIsForwardDeclaration = enumRecord.mType.HasFlag(FORWARD_DECLARATION);
+		pEnumType->mUnderlyingTypeStr = GetString(enumRecord.mUnderlyingType);
+
+		auto&& enumerators = GetEnumerators(enumRecord);
+
+		pEnumType->mEnumerators.reserve(enumerators.size());
+
+		for (auto&& currEnumerator : enumerators)
+		{
+			pEnumType->mEnumerators.emplace_back(GetString(currEnumerator));
+		}
+
+		return pEnumType;
+	}
+
+	TClassType* SymTableView::CreateClassType(const TClassRecord& classRecord, SymTable& symTable) const
+	{
+		TClassType* pClassType = symTable.CreateType<TClassType>();
+		_fillType(classRecord.mType, *pClassType);
+
+		pClassType->mIsFinal = classRecord.mType.HasFlag(FINAL);
+		pClassType->mIsStruct = classRecord.mType.HasFlag(STRUCT);
+		pClassType->mIsUnion = classRecord.mType.HasFlag(UNION);
+		pClassType->mIsForwardDeclaration = classRecord.mType.HasFlag(FORWARD_DECLARATION);
+		pClassType->mIsTemplate = classRecord.mType.HasFlag(TEMPLATE);
+
+		auto&& baseClasses = GetBaseClasses(classRecord);
+
+		pClassType->mBaseClasses.reserve(baseClasses.size());
+
+		for (auto&& currBaseClass : baseClasses)
+		{
+			pClassType->mBaseClasses.push_back({ InternString(GetString(currBaseClass.mFullName)), static_cast<bool>(currBaseClass.mIsVirtualInherited),
+												 static_cast<E_ACCESS_SPECIFIER_TYPE>(currBaseClass.mAccessSpecifier) });
+		}
+
+		auto&& fields = GetFields(classRecord);
+
+		pClassType->mFields.reserve(fields.size());
+
+		for (auto&& currField : fields)
+		{
+			pClassType->mFields.push_back({ std::string(GetString(currField.mName)), InternString(GetString(currField.mOriginalName)), static_cast<bool>(currField.mIsSerializable) });
+		}
+
+		return pClassType;
+	}
+
+	template <typename T>
+	SymTableView::TRecordsRange<T> SymTableView::_getRecords(const TArrayRef& arrayRef) const
+	{
+		const T* pFirstRecord = reinterpret_cast<const T*>(mData.data() + arrayRef.mOffset);
+		return { pFirstRecord, pFirstRecord + arrayRef.mCount };
+	}
+
+	template <typename T>
+	SymTableView::TRecordsRange<T> SymTableView::_getSubrange(const TArrayRef& arrayRef, const TArrayRef& subrangeRef) const
+	{
+		if (subrangeRef.mOffset > arrayRef.mCount || subrangeRef.mCount > arrayRef.mCount - subrangeRef.mOffset)
+		{
+			return {};
+		}
+
+		const T* pFirstRecord = _getRecords<T>(arrayRef).mpBegin + subrangeRef.mOffset;
+		return { pFirstRecord, pFirstRecord + subrangeRef.mCount };
+	}
+
+	void SymTableView::_fillType(const TTypeRecord& record, TType& type) const
+	{
+		type.mId = InternString(GetString(record.mId));
+		type.mMangledId = InternString(GetString(record.mMangledId));
+		type.mAttributes.mSectionId = GetString(record.mSectionId);
+		type.mAttributes.mFlags = static_cast<E_SERIALIZATION_ATTRIBUTES_FLAGS>(record.mSerializationFlags);
+		type.mAccessModifier = static_cast<E_ACCESS_SPECIFIER_TYPE>(record.mAccessModifier);
+		type.mIsMarkedWithAttribute = record.HasFlag(MARKED_WITH_ATTRIBUTE);
+	}
+}
@@ -1,10 +1,165 @@
 #include "../include/tokens.h"
+#include <array>
 
 
 namespace TDEngine2
 {
-	TToken::TToken(E_TOKEN_TYPE type, const std::string& value, const TCursorPos& pos):
-		mType(type), mPos(pos), mValue(value), mIsValid(true)
+	namespace
+	{
+		constexpr uint32_t KeywordsHashTableSize = 256;
+		constexpr uint32_t KeywordsCount = static_cast<uint32_t>(std::size(ReservedKeywordsTable));
+
+		static_assert(KeywordsCount < KeywordsHashTableSize, "The hash table should be larger than the keywords table");
+
+		/*!
+			\brief The hash uses only the length and three characters of a keyword, the collisions with other identifiers are resolved
+			with a single comparison of strings
+		*/
+
+		constexpr uint32_t HashKeyword(std::string_view value, uint32_t seed)
+		{
+			const size_t length = value.size();
+
+			uint32_t hash = (seed ^ static_cast<uint32_t>(length)) * 0x01000193;
+			hash = (hash ^ static_cast<uint8_t>(value[0])) * 0x01000193;
+			hash = (hash ^ static_cast<uint8_t>(value[length >> 1])) * 0x01000193;
+			hash = (hash ^ static_cast<uint8_t>(value[length - 1])) * 0x01000193;
+
+			return (hash ^ (hash >> 16)) & (KeywordsHashTableSize - 1);
+		}
+
+		constexpr bool HasKeywordsCollisions(uint32_t seed)
+		{
+			bool usedSlots[KeywordsHashTableSize] {};
+
+			for (const TReservedKeywordInfo& currKeyword : ReservedKeywordsTable)
+			{
+				const uint32_t slotIndex = HashKeyword(currKeyword.mValue, seed);
+				if (usedSlots[slotIndex])
+				{
+					return true;
+				}
+
+				usedSlots[slotIndex] = true;
+			}
+
+			return false;
+		}
+
+		constexpr uint32_t FindKeywordsHashSeed()
+		{
+			for (uint32_t seed = 0x811c9dc5; seed < 0x811c9dc5 + 4096; ++seed)
+			{
+				if (!HasKeywordsCollisions(seed))
+				{
+					return seed;
+				}
+			}
+
+			return 0;
+		}
+
+		constexpr uint32_t KeywordsHashSeed = FindKeywordsHashSeed();
+		static_assert(KeywordsHashSeed, "There is no collision free seed for the keywords hash, extend the search range or the table size");
+
+		constexpr size_t GetMinKeywordLength()
+		{
+			size_t minLength = ReservedKeywordsTable[0].mValue.size();
+
+			for (const TReservedKeywordInfo& currKeyword : ReservedKeywordsTable)
+			{
+				minLength = currKeyword.mValue.size() < minLength ? currKeyword.mValue.size() : minLength;
+			}
+
+			return minLength;
+		}
+
+		constexpr size_t GetMaxKeywordLength()
+		{
+			size_t maxLength = 0;
+
+			for (const TReservedKeywordInfo& currKeyword : ReservedKeywordsTable)
+			{
+				maxLength = currKeyword.mValue.size() > maxLength ? currKeyword.mValue.size() : maxLength;
+			}
+
+			return maxLength;
+		}
+
+		constexpr size_t MinKeywordLength = GetMinKeywordLength();
+		constexpr size_t MaxKeywordLength = GetMaxKeywordLength();
+
+		/// \note Each slot contains an index of a keyword plus one, zero means an empty slot
+		constexpr std::array<uint8_t, KeywordsHashTableSize> BuildKeywordsHashTable()
+		{
+			std::array<uint8_t, KeywordsHashTableSize> hashTable {};
+
+			for (uint32_t i = 0; i < KeywordsCount; ++i)
+			{
+				hashTable[HashKeyword(ReservedKeywordsTable[i].mValue, KeywordsHashSeed)] = static_cast<uint8_t>(i + 1);
+			}
+
+			return hashTable;
+		}
+
+		constexpr std::array<uint8_t, KeywordsHashTableSize> KeywordsHashTable = BuildKeywordsHashTable();
+	}
+
+
+	E_TOKEN_TYPE GetKeywordTokenType(std::string_view value)
+	{
+		if (value.size() < MinKeywordLength || value.size() > MaxKeywordLength)
+		{
+			return E_TOKEN_TYPE::TT_IDENTIFIER;
+		}
+
+		const uint8_t slotValue = KeywordsHashTable[HashKeyword(value, KeywordsHashSeed)];
+		if (!slotValue)
+		{
+			return E_TOKEN_TYPE::TT_IDENTIFIER;
+		}
+
+		const TReservedKeywordInfo& keywordInfo = ReservedKeywordsTable[slotValue - 1];
+
+		return (keywordInfo.mValue == value) ? keywordInfo.mType : E_TOKEN_TYPE::TT_IDENTIFIER;
+	}
+
+	E_TOKEN_TYPE GetPunctuatorTokenType(std::string_view value)
+	{
+		switch (value.size())
+		{
+			case 1:
+				switch (value[0])
+				{
+					case '{': return E_TOKEN_TYPE::TT_OPEN_BRACE;
+					case '}': return E_TOKEN_TYPE::TT_CLOSE_BRACE;
+					case '(': return E_TOKEN_TYPE::TT_OPEN_PARENTHES;
+					case ')': return E_TOKEN_TYPE::TT_CLOSE_PARENTHES;
+					case ':': return E_TOKEN_TYPE::TT_COLON;
+					case ';': return E_TOKEN_TYPE::TT_SEMICOLON;
+					case '=': return E_TOKEN_TYPE::TT_ASSIGN_OP;
+					case ',': return E_TOKEN_TYPE::TT_COMMA;
+					case '<': return E_TOKEN_TYPE::TT_LESS;
+					case '>': return E_TOKEN_TYPE::TT_GREAT;
+					case '|': return E_TOKEN_TYPE::TT_PIPE;
+				}
+				break;
+			case 2:
+				switch (value[0])
+				{
+					case '-': return (value[1] == '>') ? E_TOKEN_TYPE::TT_ARROW : ((value[1] == '-') ? E_TOKEN_TYPE::TT_DECREMENT : E_TOKEN_TYPE::TT_UNKNOWN);
+					case '+': return (value[1] == '+') ? E_TOKEN_TYPE::TT_INCREMENT : E_TOKEN_TYPE::TT_UNKNOWN;
+					case '<': return (value[1] == '<') ? E_TOKEN_TYPE::TT_LEFT_SHIFT : E_TOKEN_TYPE::TT_UNKNOWN;
+					case '>': return (value[1] == '>') ? E_TOKEN_TYPE::TT_RIGHT_SHIFT : E_TOKEN_TYPE::TT_UNKNOWN;
+				}
+				break;
+		}
+
+		return E_TOKEN_TYPE::TT_UNKNOWN;
+	}
+
+	TToken::TToken(E_TOKEN_TYPE type, std::string_view value, uint32_t offset):
+		mType(type), mOffset(offset), mValue(value), mIsValid(true)
 	{
 	}
 
@@ -39,6 +194,10 @@ namespace TDEngine2
 				return ",";
 			case E_TOKEN_TYPE::TT_NUMBER:
 				return "NUMBER";
+			case E_TOKEN_TYPE::TT_STRING_LITERAL:
+				return "STRING";
+			case E_TOKEN_TYPE::TT_CHAR_LITERAL:
+				return "CHAR_LITERAL";
 			case E_TOKEN_TYPE::TT_UNKNOWN:
 				return "UNKNOWN";
 		}
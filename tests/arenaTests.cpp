@@ -0,0 +1,77 @@
+#include <arena.h>
+#include <symtable.h>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+
+using namespace TDEngine2;
+
+
+TEST_CASE("MemoryArena tests")
+{
+	SECTION("TestCreate_CreateObjectsOfDifferentAlignments_ReturnsProperlyAlignedPointers")
+	{
+		MemoryArena arena(256);
+
+		for (uint32_t i = 0; i < 100; ++i)
+		{
+			auto pChar = arena.Create<char>('a');
+			auto pDouble = arena.Create<double>(1.0);
+			auto pInt = arena.Create<uint32_t>(i);
+
+			REQUIRE(*pChar == 'a');
+			REQUIRE(*pDouble == 1.0);
+			REQUIRE(*pInt == i);
+
+			REQUIRE(reinterpret_cast<uintptr_t>(pDouble) % alignof(double) == 0);
+			REQUIRE(reinterpret_cast<uintptr_t>(pInt) % alignof(uint32_t) == 0);
+		}
+	}
+
+	SECTION("TestAllocate_AllocateBlockLargerThanArenaBlock_ReturnsValidMemory")
+	{
+		MemoryArena arena(64);
+
+		auto pData = static_cast<char*>(arena.Allocate(1024));
+		REQUIRE(pData);
+
+		std::fill(pData, pData + 1024, 'x');
+		REQUIRE(arena.GetUsedSize() >= 1024);
+	}
+
+	SECTION("TestReset_CreateNonTrivialObjects_DestructorsAreCalledInReverseOrder")
+	{
+		struct TDestructible
+		{
+			std::string& mLog;
+			char mId;
+
+			~TDestructible() { mLog.push_back(mId); }
+		};
+
+		std::string log;
+
+		MemoryArena arena;
+		arena.Create<TDestructible>(TDestructible{ log, 'a' });
+		arena.Create<TDestructible>(TDestructible{ log, 'b' });
+
+		log.clear(); // \note Temporaries have been destroyed already
+		arena.Reset();
+
+		REQUIRE(log == "ba");
+		REQUIRE(arena.GetUsedSize() == 0);
+	}
+
+	SECTION("TestSymTable_CreateTypes_TypesAreOwnedByTheTable")
+	{
+		SymTable symTable;
+
+		auto pClassType = symTable.CreateType<TClassType>();
+		auto pEnumType = symTable.CreateType<TEnumType>();
+		pEnumType->mpParentType = pClassType;
+
+		REQUIRE(pClassType->mpOwner == &symTable);
+		REQUIRE(pEnumType->mpOwner == &symTable);
+		REQUIRE(pEnumType->mpParentType == pClassType);
+	}
+}
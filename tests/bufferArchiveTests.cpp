@@ -0,0 +1,121 @@
+#include <bufferarchive.h>
+#include <symtable.h>
+#include <catch2/catch_test_macros.hpp>
+#include <limits>
+
+
+using namespace TDEngine2;
+
+
+TEST_CASE("BufferArchive tests")
+{
+	SECTION("TestWrite_PassSmallIntegers_EachTakesSingleByte")
+	{
+		BufferWriterArchive archive;
+		archive << static_cast<uint64_t>(127) << static_cast<size_t>(0) << -1 << 63 << true;
+
+		REQUIRE(archive.GetBuffer().size() == 5);
+
+		archive << static_cast<uint32_t>(128);
+		REQUIRE(archive.GetBuffer().size() == 7);
+	}
+
+	SECTION("TestRead_PassWrittenValues_ReturnsSameValues")
+	{
+		BufferWriterArchive writer;
+		writer << (std::numeric_limits<uint64_t>::max)() << (std::numeric_limits<int64_t>::min)() << (std::numeric_limits<int32_t>::max)();
+		writer << static_cast<int16_t>(-300) << false << std::string("TDEngine2") << "" << E_ACCESS_SPECIFIER_TYPE::PROTECTED;
+
+		BufferReaderArchive reader(writer.GetBuffer());
+
+		uint64_t unsignedValue = 0;
+		int64_t signedValue = 0;
+		int32_t intValue = 0;
+		int16_t shortValue = 0;
+		bool boolValue = true;
+		std::string firstStr, secondStr = "not empty";
+		E_ACCESS_SPECIFIER_TYPE accessSpecifier = E_ACCESS_SPECIFIER_TYPE::PUBLIC;
+
+		reader >> unsignedValue >> signedValue >> intValue >> shortValue >> boolValue >> firstStr >> secondStr >> accessSpecifier;
+
+		REQUIRE(!reader.HasFailed());
+		REQUIRE(reader.GetRemainingSize() == 0);
+
+		REQUIRE(unsignedValue == (std::numeric_limits<uint64_t>::max)());
+		REQUIRE(signedValue == (std::numeric_limits<int64_t>::min)());
+		REQUIRE(intValue == (std::numeric_limits<int32_t>::max)());
+		REQUIRE(shortValue == -300);
+		REQUIRE(!boolValue);
+		REQUIRE(firstStr == "TDEngine2");
+		REQUIRE(secondStr.empty());
+		REQUIRE(accessSpecifier == E_ACCESS_SPECIFIER_TYPE::PROTECTED);
+	}
+
+	SECTION("TestRead_PassTruncatedData_ArchiveFailsAndReturnsZeros")
+	{
+		BufferWriterArchive writer;
+		writer << std::string("TDEngine2") << static_cast<uint32_t>(1000);
+
+		const std::string& data = writer.GetBuffer();
+
+		BufferReaderArchive reader(std::string_view(data).substr(0, data.size() - 1));
+
+		std::string str;
+		uint32_t value = 42;
+
+		reader >> str >> value;
+
+		REQUIRE(str == "TDEngine2");
+		REQUIRE(value == 0);
+		REQUIRE(reader.HasFailed());
+
+		reader >> str;
+		REQUIRE(str.empty());
+	}
+
+	SECTION("TestRead_PassValueThatDoesntFitIntoType_ArchiveFails")
+	{
+		BufferWriterArchive writer;
+		writer << (static_cast<uint64_t>(1) << 32);
+
+		uint8_t value = 42;
+
+		BufferReaderArchive reader(writer.GetBuffer());
+		reader >> value;
+
+		REQUIRE(value == 0);
+		REQUIRE(reader.HasFailed());
+	}
+
+	SECTION("TestRead_PassOverlongVarint_ArchiveFails")
+	{
+		const std::string data(11, '\x80');
+
+		uint64_t value = 42;
+
+		BufferReaderArchive reader(data);
+		reader >> value;
+
+		REQUIRE(value == 0);
+		REQUIRE(reader.HasFailed());
+	}
+
+	SECTION("TestLoad_PassTruncatedSymTable_ReturnsFalse")
+	{
+		SymTable symTable;
+
+		symTable.CreateScope("A");
+		symTable.AddSymbol({ "a" });
+		symTable.ExitScope();
+
+		BufferWriterArchive writer;
+		REQUIRE(symTable.Save(writer));
+
+		const std::string& data = writer.GetBuffer();
+
+		BufferReaderArchive reader(std::string_view(data).substr(0, data.size() / 2));
+
+		SymTable loadedSymTable;
+		REQUIRE(!loadedSymTable.Load(reader));
+	}
+}
@@ -0,0 +1,126 @@
+#include <cachepack.h>
+#include <symtable.h>
+#include <bufferarchive.h>
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <cstdio>
+
+
+using namespace TDEngine2;
+
+
+const std::string TestCachePackFilename = "cache_pack_test.pack";
+
+
+TEST_CASE("CachePack tests")
+{
+	SECTION("TestSave_AddBlobsAndReopenPack_ReturnsSameBlobsForTheirKeys")
+	{
+		const THash128 firstKey = ComputeHash128("first");
+		const THash128 secondKey = ComputeHash128("second");
+
+		{
+			CachePack pack;
+			REQUIRE(!pack.Open("__missing_cache_pack__"));
+
+			pack.Add(firstKey, "first blob");
+			pack.Add(secondKey, std::string("second\0blob", 11));
+
+			REQUIRE(pack.Save(TestCachePackFilename));
+		}
+
+		CachePack pack;
+		REQUIRE(pack.Open(TestCachePackFilename));
+
+		REQUIRE(pack.Find(firstKey) == "first blob");
+		REQUIRE(pack.Find(secondKey) == std::string_view("second\0blob", 11));
+		REQUIRE(pack.Find(ComputeHash128("third")).empty());
+
+		std::remove(TestCachePackFilename.c_str());
+	}
+
+	SECTION("TestSave_FindOnlyPartOfBlobs_NextPackContainsOnlyFoundAndNewBlobs")
+	{
+		const THash128 firstKey = ComputeHash128("first");
+		const THash128 secondKey = ComputeHash128("second");
+		const THash128 thirdKey = ComputeHash128("third");
+
+		{
+			CachePack pack;
+			pack.Add(firstKey, "first blob");
+			pack.Add(secondKey, "second blob");
+
+			REQUIRE(pack.Save(TestCachePackFilename));
+		}
+
+		{
+			CachePack pack;
+			REQUIRE(pack.Open(TestCachePackFilename));
+			REQUIRE(pack.Find(secondKey) == "second blob");
+
+			pack.Add(thirdKey, "third blob");
+
+			REQUIRE(pack.Save(TestCachePackFilename));
+		}
+
+		CachePack pack;
+		REQUIRE(pack.Open(TestCachePackFilename));
+
+		REQUIRE(pack.Find(firstKey).empty());
+		REQUIRE(pack.Find(secondKey) == "second blob");
+		REQUIRE(pack.Find(thirdKey) == "third blob");
+
+		std::remove(TestCachePackFilename.c_str());
+	}
+
+	SECTION("TestOpen_PassFileOfUnknownFormat_ReturnsFalse")
+	{
+		{
+			std::ofstream file(TestCachePackFilename, std::ios::binary);
+			file << "index.cache of some other format";
+		}
+
+		CachePack pack;
+		REQUIRE(!pack.Open(TestCachePackFilename));
+		REQUIRE(pack.Find(ComputeHash128("first")).empty());
+
+		std::remove(TestCachePackFilename.c_str());
+	}
+
+	SECTION("TestLoad_PassSymTableBlobFromPack_SymTableIsRestoredInPlace")
+	{
+		const THash128 key = ComputeHash128("symtable");
+
+		{
+			SymTable symTable;
+
+			symTable.CreateScope("A");
+			symTable.AddSymbol({ "a" });
+			symTable.ExitScope();
+
+			BufferWriterArchive archive;
+
+			REQUIRE(symTable.Save(archive));
+
+			CachePack pack;
+			pack.Add(key, std::string(archive.GetBuffer()));
+
+			REQUIRE(pack.Save(TestCachePackFilename));
+		}
+
+		{
+			CachePack pack;
+			REQUIRE(pack.Open(TestCachePackFilename));
+
+			BufferReaderArchive archive(pack.Find(key));
+
+			SymTable symTable;
+			REQUIRE(symTable.Load(archive));
+
+			SymTable::TScopeEntity* pScope = symTable.LookUpNamedScope("A");
+			REQUIRE((pScope && pScope->mVariables.size() == 1 && pScope->mVariables[0].mName == "a"));
+		}
+
+		std::remove(TestCachePackFilename.c_str());
+	}
+}
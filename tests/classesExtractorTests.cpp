@@ -4,29 +4,63 @@
 
 using namespace TDEngine2;
 
-using Scope = SymTable::TScopeEntity;
-using ScopePtr = std::unique_ptr<SymTable::TScopeEntity>;
-
 
 TEST_CASE("ClassesExtractor's tests")
 {
 	SECTION("TestVisitScope_PassClassThatHasNonpublicAccessModifier_ExtractorHasNoOutput")
 	{
-		ScopePtr pClassScope = std::make_unique<Scope>();
-		pClassScope->mpType = std::make_unique<TClassType>();
-		if (TClassType* pEnumType = dynamic_cast<TClassType*>(pClassScope->mpType.get()))
-		{
-			pEnumType->mId = "TestClass";
-			pEnumType->mAccessModifier = E_ACCESS_SPECIFIER_TYPE::PROTECTED;
-		}
+		SymTable symTable;
+
+		symTable.CreateScope("TestClass");
+		symTable.ExitScope();
+
+		TClassType* pClassType = symTable.CreateType<TClassType>();
+		pClassType->mId = InternString("TestClass");
+		pClassType->mAccessModifier = E_ACCESS_SPECIFIER_TYPE::PROTECTED;
 
-		ScopePtr pRootScope = std::make_unique<Scope>();
-		pRootScope->mpNamedScopes["TestClass"] = std::move(pClassScope);
+		symTable.SetScopeType(*symTable.LookUpNamedScope("TestClass"), pClassType);
 
 		ClassMetaExtractor extractor(E_EMIT_FLAGS::ALL);
-		extractor.VisitScope(*pRootScope.get());
+		extractor.Extract(symTable);
 
 		auto&& classes = extractor.GetTypesInfo();
 		REQUIRE(classes.empty());
 	}
+
+	SECTION("TestMerge_PassClassDefinedInSeveralTables_LatestDefinitionWinsRegardlessOfMergeOrder")
+	{
+		constexpr uint32_t tablesCount = 3;
+
+		SymTable symTables[tablesCount];
+		std::vector<ClassMetaExtractor> extractors;
+
+		for (uint32_t i = 0; i < tablesCount; ++i)
+		{
+			symTables[i].CreateScope("TestClass");
+			symTables[i].ExitScope();
+
+			TClassType* pClassType = symTables[i].CreateType<TClassType>();
+			pClassType->mId = InternString("TestClass");
+			pClassType->mMangledId = symTables[i].LookUpNamedScope("TestClass")->mMangledId;
+			pClassType->mIsForwardDeclaration = (i == tablesCount - 1); // \note The last table contains only a forward declaration
+
+			symTables[i].SetScopeType(*symTables[i].LookUpNamedScope("TestClass"), pClassType);
+
+			extractors.emplace_back(E_EMIT_FLAGS::ALL);
+			extractors.back().Extract(symTables[i]);
+		}
+
+		MetaTypesMergeTable<TClassType> directOrderTable;
+		MetaTypesMergeTable<TClassType> reversedOrderTable;
+
+		for (uint32_t i = 0; i < tablesCount; ++i)
+		{
+			directOrderTable.Merge(extractors[i], i);
+			reversedOrderTable.Merge(extractors[tablesCount - 1 - i], tablesCount - 1 - i);
+		}
+
+		auto&& classes = directOrderTable.GetTypes();
+		REQUIRE((classes.size() == 1 && classes[0] == extractors[1].GetTypesInfo()[0]));
+		REQUIRE(classes == reversedOrderTable.GetTypes());
+	}
 }
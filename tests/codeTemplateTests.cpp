@@ -0,0 +1,42 @@
+#include <codetemplate.h>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+
+using namespace TDEngine2;
+
+
+TEST_CASE("CodeTemplate tests")
+{
+	SECTION("TestEmit_PassPatternWithRepeatedPlaceholders_ReplacesAllOfThem")
+	{
+		const CodeTemplate codeTemplate("ClassFieldInfo<{0}, decltype({0}::{2})> { \"{1}\", &{0}::{2}, {3} }");
+
+		REQUIRE(codeTemplate.ToString({ "::A", "x", "mX", "true" }) == "ClassFieldInfo<::A, decltype(::A::mX)> { \"x\", &::A::mX, true }");
+	}
+
+	SECTION("TestEmit_PassPatternWithBracesThatArentPlaceholders_KeepsThemAsIs")
+	{
+		const CodeTemplate codeTemplate("{ {0} } {} {a} {12");
+
+		REQUIRE(codeTemplate.GetLiteralsSize() == 15);
+		REQUIRE(codeTemplate.ToString({ "value" }) == "{ value } {} {a} {12");
+	}
+
+	SECTION("TestEmit_PassLessArgumentsThanPlaceholders_KeepsUnknownPlaceholders")
+	{
+		const CodeTemplate codeTemplate("{0} + {1} = {10}");
+
+		REQUIRE(codeTemplate.ToString({ "1" }) == "1 + {1} = {10}");
+	}
+
+	SECTION("TestEmit_PassNonEmptyOutput_AppendsToIt")
+	{
+		const CodeTemplate codeTemplate("\n#ifdef META_EXPORT_{0}_SECTION\n");
+
+		std::string output = "prefix";
+		codeTemplate.Emit(output, { "ALL" });
+
+		REQUIRE(output == "prefix\n#ifdef META_EXPORT_ALL_SECTION\n");
+	}
+}
@@ -4,31 +4,28 @@
 
 using namespace TDEngine2;
 
-using Scope = SymTable::TScopeEntity;
-using ScopePtr = std::unique_ptr<SymTable::TScopeEntity>;
-
 
 TEST_CASE("EnumExtractor's tests")
 {
 	SECTION("TestVisitScope_PassRootNode_ExtractsAllEnumsInRootNode")
 	{
-		ScopePtr pEnumScope = std::make_unique<Scope>();
-		pEnumScope->mpType = std::make_unique<TEnumType>();
-		if (TEnumType* pEnumType = dynamic_cast<TEnumType*>(pEnumScope->mpType.get()))
-		{
-			pEnumType->mId = "TestEnum";
-			pEnumType->mIsStronglyTyped = true;
+		SymTable symTable;
 
-			pEnumType->mEnumerators.push_back("FIRST");
-			pEnumType->mEnumerators.push_back("SECOND");
-			pEnumType->mEnumerators.push_back("THIRD");
-		}
+		symTable.CreateScope("TestEnum");
+		symTable.ExitScope();
+
+		TEnumType* pEnumType = symTable.CreateType<TEnumType>();
+		pEnumType->mId = InternString("TestEnum");
+		pEnumType->mIsStronglyTyped = true;
+
+		pEnumType->mEnumerators.push_back("FIRST");
+		pEnumType->mEnumerators.push_back("SECOND");
+		pEnumType->mEnumerators.push_back("THIRD");
 
-		ScopePtr pRootScope = std::make_unique<Scope>();
-		pRootScope->mpNamedScopes["TestEnum"] = std::move(pEnumScope);
+		symTable.SetScopeType(*symTable.LookUpNamedScope("TestEnum"), pEnumType);
 
 		EnumsMetaExtractor extractor(E_EMIT_FLAGS::ALL);
-		extractor.VisitScope(*pRootScope.get());
+		extractor.Extract(symTable);
 
 		auto&& enums = extractor.GetTypesInfo();
 		REQUIRE((enums.size() == 1 && enums[0]->mId == "TestEnum" && enums[0]->mEnumerators.size() == 3));
@@ -36,26 +33,100 @@ TEST_CASE("EnumExtractor's tests")
 
 	SECTION("TestVisitScope_PassEnumThatHasNonpublicAccessModifier_ExtractorHasNoOutput")
 	{
-		ScopePtr pEnumScope = std::make_unique<Scope>();
-		pEnumScope->mpType = std::make_unique<TEnumType>();
-		if (TEnumType* pEnumType = dynamic_cast<TEnumType*>(pEnumScope->mpType.get()))
+		SymTable symTable;
+
+		symTable.CreateScope("TestEnum");
+		symTable.ExitScope();
+
+		TEnumType* pEnumType = symTable.CreateType<TEnumType>();
+		pEnumType->mId = InternString("TestEnum");
+		pEnumType->mIsStronglyTyped = true;
+		pEnumType->mAccessModifier = E_ACCESS_SPECIFIER_TYPE::PROTECTED;
+
+		pEnumType->mEnumerators.push_back("FIRST");
+		pEnumType->mEnumerators.push_back("SECOND");
+		pEnumType->mEnumerators.push_back("THIRD");
+
+		symTable.SetScopeType(*symTable.LookUpNamedScope("TestEnum"), pEnumType);
+
+		EnumsMetaExtractor extractor(E_EMIT_FLAGS::ALL);
+		extractor.Extract(symTable);
+
+		auto&& enums = extractor.GetTypesInfo();
+		REQUIRE(enums.empty());
+	}
+
+	SECTION("TestExtract_PassTableWithDifferentTypes_ReturnsSameEnumsAsFullTraversal")
+	{
+		SymTable symTable;
+
+		symTable.CreateScope("Engine");
+		symTable.SetScopeType(*symTable.LookUpNamedScope("Engine"), symTable.CreateType<TNamespaceType>());
+
+		for (const std::string& currName : { "E_FIRST", "TClass", "E_SECOND" })
 		{
-			pEnumType->mId = "TestEnum";
-			pEnumType->mIsStronglyTyped = true;
-			pEnumType->mAccessModifier = E_ACCESS_SPECIFIER_TYPE::PROTECTED;
+			symTable.CreateScope(currName);
+
+			TType* pType = (currName[0] == 'E') ? static_cast<TType*>(symTable.CreateType<TEnumType>()) : symTable.CreateType<TClassType>();
+			pType->mId = InternString(currName);
+			pType->mMangledId = symTable.LookUpNamedScope(currName)->mMangledId;
 
-			pEnumType->mEnumerators.push_back("FIRST");
-			pEnumType->mEnumerators.push_back("SECOND");
-			pEnumType->mEnumerators.push_back("THIRD");
+			symTable.SetScopeType(*symTable.LookUpNamedScope(currName), pType);
+			symTable.ExitScope();
 		}
 
-		ScopePtr pRootScope = std::make_unique<Scope>();
-		pRootScope->mpNamedScopes["TestEnum"] = std::move(pEnumScope);
+		symTable.ExitScope();
+
+		REQUIRE(symTable.GetTypedScopes(TType::E_SUBTYPE::ENUM).size() == 2);
+		REQUIRE(symTable.GetTypedScopes(TType::E_SUBTYPE::CLASS).size() == 1);
+		REQUIRE(symTable.GetTypedScopes(TType::E_SUBTYPE::NAMESPACE).size() == 1);
 
 		EnumsMetaExtractor extractor(E_EMIT_FLAGS::ALL);
-		extractor.VisitScope(*pRootScope.get());
+		extractor.Extract(symTable);
+
+		EnumsMetaExtractor traversalExtractor(E_EMIT_FLAGS::ALL);
+		symTable.Visit(traversalExtractor);
 
 		auto&& enums = extractor.GetTypesInfo();
-		REQUIRE(enums.empty());
+		REQUIRE(enums == traversalExtractor.GetTypesInfo());
+		REQUIRE((enums.size() == 2 && enums[0]->mId == "E_FIRST" && enums[1]->mId == "E_SECOND"));
+	}
+
+	SECTION("TestMerge_PassForwardDeclarationAndDefinitionFromDifferentTables_DefinitionWinsRegardlessOfMergeOrder")
+	{
+		SymTable symTables[2];
+
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			symTables[i].CreateScope("TestEnum");
+			symTables[i].ExitScope();
+
+			TEnumType* pEnumType = symTables[i].CreateType<TEnumType>();
+			pEnumType->mId = InternString("TestEnum");
+			pEnumType->mMangledId = symTables[i].LookUpNamedScope("TestEnum")->mMangledId;
+
+			if (i) // \note The first table contains only a forward declaration
+			{
+				pEnumType->mEnumerators.push_back("FIRST");
+			}
+
+			symTables[i].SetScopeType(*symTables[i].LookUpNamedScope("TestEnum"), pEnumType);
+		}
+
+		EnumsMetaExtractor extractors[2] { EnumsMetaExtractor(E_EMIT_FLAGS::ALL), EnumsMetaExtractor(E_EMIT_FLAGS::ALL) };
+		extractors[0].Extract(symTables[0]);
+		extractors[1].Extract(symTables[1]);
+
+		MetaTypesMergeTable<TEnumType> directOrderTable;
+		directOrderTable.Merge(extractors[0], 0);
+		directOrderTable.Merge(extractors[1], 1);
+
+		MetaTypesMergeTable<TEnumType> reversedOrderTable;
+		reversedOrderTable.Merge(extractors[1], 1);
+		reversedOrderTable.Merge(extractors[0], 0);
+
+		auto&& enums = directOrderTable.GetTypes();
+		REQUIRE((enums.size() == 1 && enums[0]->mEnumerators.size() == 1));
+		REQUIRE(enums == reversedOrderTable.GetTypes());
 	}
 }
@@ -0,0 +1,45 @@
+#include <hash.h>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <set>
+
+
+using namespace TDEngine2;
+
+
+TEST_CASE("Hash128 tests")
+{
+	SECTION("TestComputeHash128_PassKnownInputs_ReturnsReferenceValues")
+	{
+		REQUIRE(ComputeHash128("") == THash128{});
+
+		const THash128 hash = ComputeHash128("The quick brown fox jumps over the lazy dog");
+		REQUIRE(hash.mLow == 0xe34bbc7bbc071b6cull);
+		REQUIRE(hash.mHigh == 0x7a433ca9c49a9347ull);
+		REQUIRE(hash.ToString() == "7a433ca9c49a9347e34bbc7bbc071b6c");
+	}
+
+	SECTION("TestComputeHash128_PassPrefixesOfAllTailSizes_ReturnsUniqueHashes")
+	{
+		const std::string str = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+		std::set<std::string> hashes;
+
+		for (size_t i = 0; i <= str.size(); ++i)
+		{
+			hashes.insert(ComputeHash128(std::string_view(str).substr(0, i)).ToString());
+		}
+
+		REQUIRE(hashes.size() == str.size() + 1);
+	}
+
+	SECTION("TestComputeHash128_PassSameDataFromDifferentBuffersOrDifferentSeeds_HashesDependOnlyOnContentAndSeed")
+	{
+		const std::string first = "struct A { int mValue; };";
+		const std::string second = first;
+
+		REQUIRE(ComputeHash128(first) == ComputeHash128(second));
+		REQUIRE(ComputeHash128(first, 1) != ComputeHash128(second));
+		REQUIRE(ComputeHash128(first, 1) == ComputeHash128(second, 1));
+	}
+}
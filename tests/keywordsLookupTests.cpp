@@ -0,0 +1,89 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <tokens.h>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+
+using namespace TDEngine2;
+
+
+static const std::vector<std::string> SampleIdentifiers
+{
+	"namespace", "TDEngine2", "class", "CBaseObject", "public", "virtual", "void", "Update", "float", "dt", "override",
+	"struct", "TVector3", "float", "x", "y", "z", "enum", "E_RESULT_CODE", "uint32_t", "OK", "FAIL", "static",
+	"std", "string", "mName", "const", "bool", "mIsEnabled", "CLASS_META", "FIELD_META", "SERIALIZE_ALL_FIELDS", "unsigned",
+	"int", "mCount", "template", "typename", "TArgs", "inline", "using", "TPtr", "shared_ptr", "private", "mpOwner",
+};
+
+
+TEST_CASE("Keywords lookup tests")
+{
+	SECTION("TestGetKeywordTokenType_PassEachReservedKeyword_ReturnsItsTokenType")
+	{
+		for (const TReservedKeywordInfo& currKeyword : ReservedKeywordsTable)
+		{
+			REQUIRE(GetKeywordTokenType(currKeyword.mValue) == currKeyword.mType);
+		}
+	}
+
+	SECTION("TestGetKeywordTokenType_PassNonReservedIdentifiers_ReturnsIdentifierType")
+	{
+		for (const std::string& currIdentifier : { "a", "names", "Class", "structure", "char64_t", "ENUM_METADATA", "SECTIONS", "inlined", "_" })
+		{
+			REQUIRE(GetKeywordTokenType(currIdentifier) == E_TOKEN_TYPE::TT_IDENTIFIER);
+		}
+	}
+
+	SECTION("TestGetPunctuatorTokenType_PassOneAndTwoCharactersPunctuators_ReturnsCorrectTypes")
+	{
+		REQUIRE(GetPunctuatorTokenType("{") == E_TOKEN_TYPE::TT_OPEN_BRACE);
+		REQUIRE(GetPunctuatorTokenType("|") == E_TOKEN_TYPE::TT_PIPE);
+		REQUIRE(GetPunctuatorTokenType("->") == E_TOKEN_TYPE::TT_ARROW);
+		REQUIRE(GetPunctuatorTokenType("--") == E_TOKEN_TYPE::TT_DECREMENT);
+		REQUIRE(GetPunctuatorTokenType(">>") == E_TOKEN_TYPE::TT_RIGHT_SHIFT);
+		REQUIRE(GetPunctuatorTokenType("-") == E_TOKEN_TYPE::TT_UNKNOWN);
+		REQUIRE(GetPunctuatorTokenType("<>") == E_TOKEN_TYPE::TT_UNKNOWN);
+		REQUIRE(GetPunctuatorTokenType("") == E_TOKEN_TYPE::TT_UNKNOWN);
+	}
+}
+
+
+TEST_CASE("Keywords lookup benchmarks", "[.][benchmark]")
+{
+	/// \note The baseline reproduces the previous implementation of the lexer that's used a hash map with temporary strings as keys
+	std::unordered_map<std::string, E_TOKEN_TYPE> keywordsMap;
+
+	for (const TReservedKeywordInfo& currKeyword : ReservedKeywordsTable)
+	{
+		keywordsMap.emplace(std::string(currKeyword.mValue), currKeyword.mType);
+	}
+
+	std::vector<std::string_view> identifiers(SampleIdentifiers.cbegin(), SampleIdentifiers.cend());
+
+	BENCHMARK("std::unordered_map lookup")
+	{
+		uint32_t keywordsCount = 0;
+
+		for (std::string_view currIdentifier : identifiers)
+		{
+			auto it = keywordsMap.find(std::string(currIdentifier));
+			keywordsCount += (it != keywordsMap.cend());
+		}
+
+		return keywordsCount;
+	};
+
+	BENCHMARK("Perfect hash lookup")
+	{
+		uint32_t keywordsCount = 0;
+
+		for (std::string_view currIdentifier : identifiers)
+		{
+			keywordsCount += (GetKeywordTokenType(currIdentifier) != E_TOKEN_TYPE::TT_IDENTIFIER);
+		}
+
+		return keywordsCount;
+	};
+}
@@ -1,5 +1,7 @@
 #include <vector>
 #include <string>
+#include <fstream>
+#include <cstdio>
 #include <lexer.h>
 #include "mockInputStream.h"
 #include <catch2/catch_test_macros.hpp>
@@ -185,11 +187,11 @@ TEST_CASE("Lexer tests")
 		REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_EOF);
 	}
 
-	/*SECTION("TestGetNextToken_PassNumberLiterals_ReturnsSequenceOfTokens")
+	SECTION("TestGetNextToken_PassNumberLiterals_ReturnsSequenceOfTokens")
 	{
 		std::unique_ptr<IInputStream> stream{ new MockInputStream {
 			{
-				"42"
+				"42 0x1F 0b1010u 3.14f .5 1e-10 0x1.8p+3 1'000'000ull 42;"
 			} } };
 
 		Lexer lexer(*stream);
@@ -198,9 +200,18 @@ TEST_CASE("Lexer tests")
 
 		uint32_t currExpectedTokenIndex = 0;
 
-		std::vector<E_TOKEN_TYPE> expectedTokens
+		std::vector<std::tuple<E_TOKEN_TYPE, std::string>> expectedTokens
 		{
-			E_TOKEN_TYPE::TT_NUMBER,
+			{ E_TOKEN_TYPE::TT_NUMBER, "42" },
+			{ E_TOKEN_TYPE::TT_NUMBER, "0x1F" },
+			{ E_TOKEN_TYPE::TT_NUMBER, "0b1010u" },
+			{ E_TOKEN_TYPE::TT_NUMBER, "3.14f" },
+			{ E_TOKEN_TYPE::TT_NUMBER, ".5" },
+			{ E_TOKEN_TYPE::TT_NUMBER, "1e-10" },
+			{ E_TOKEN_TYPE::TT_NUMBER, "0x1.8p+3" },
+			{ E_TOKEN_TYPE::TT_NUMBER, "1'000'000ull" },
+			{ E_TOKEN_TYPE::TT_NUMBER, "42" },
+			{ E_TOKEN_TYPE::TT_SEMICOLON, ";" },
 		};
 
 		while ((pCurrToken = &lexer.GetNextToken())->mType != E_TOKEN_TYPE::TT_EOF)
@@ -211,9 +222,46 @@ TEST_CASE("Lexer tests")
 				break;
 			}
 
-			REQUIRE(pCurrToken->mType == expectedTokens[currExpectedTokenIndex++]);
+			const auto& expectedToken = expectedTokens[currExpectedTokenIndex++];
+
+			REQUIRE(pCurrToken->mType == std::get<E_TOKEN_TYPE>(expectedToken));
+			REQUIRE(pCurrToken->mValue == std::get<std::string>(expectedToken));
+		}
+
+		REQUIRE(currExpectedTokenIndex == expectedTokens.size());
+	}
+
+	SECTION("TestGetNextToken_PassStringAndCharLiterals_ReturnsSingleTokenPerLiteral")
+	{
+		std::unique_ptr<IInputStream> stream{ new MockInputStream {
+			{
+				"const char* p = \"a;b\\\"c}\"; char c = '\\''; auto s = u8\"x\" L'y' U\"\";",
+				"auto r = R\"tag(first \" line)\"",
+				"second line)tag\"; auto u = \"unterminated",
+				"int i;",
+			} } };
+
+		Lexer lexer(*stream);
+
+		const TToken* pCurrToken = nullptr;
+
+		std::vector<std::string> literals;
+
+		while ((pCurrToken = &lexer.GetNextToken())->mType != E_TOKEN_TYPE::TT_EOF)
+		{
+			if (E_TOKEN_TYPE::TT_STRING_LITERAL == pCurrToken->mType || E_TOKEN_TYPE::TT_CHAR_LITERAL == pCurrToken->mType)
+			{
+				literals.emplace_back(pCurrToken->mValue);
+			}
 		}
-	}*/
+
+		const std::vector<std::string> expectedLiterals
+		{
+			"\"a;b\\\"c}\"", "'\\''", "u8\"x\"", "L'y'", "U\"\"", "R\"tag(first \" line)\"\nsecond line)tag\"", "\"unterminated",
+		};
+
+		REQUIRE(literals == expectedLiterals);
+	}
 
 	SECTION("TestGetNextToken_PassStronglyTypedEnum_ReturnsTokens")
 	{
@@ -273,10 +321,10 @@ TEST_CASE("Lexer tests")
 
 		Lexer lexer(*stream);
 
-		REQUIRE(lexer.GetNextToken().mPos == std::tuple<uint32_t, uint32_t>(1, 1));
-		REQUIRE(lexer.GetNextToken().mPos == std::tuple<uint32_t, uint32_t>(1, 2));
-		REQUIRE(lexer.GetNextToken().mPos == std::tuple<uint32_t, uint32_t>(1, 3));
-		REQUIRE(lexer.GetNextToken().mPos == std::tuple<uint32_t, uint32_t>(1, 4));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(1, 1));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(1, 2));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(1, 3));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(1, 4));
 		REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_EOF);
 	}
 
@@ -289,13 +337,35 @@ TEST_CASE("Lexer tests")
 
 		Lexer lexer(*stream);
 
-		REQUIRE(lexer.GetNextToken().mPos == std::tuple<uint32_t, uint32_t>(1, 1));
-		REQUIRE(lexer.GetNextToken().mPos == std::tuple<uint32_t, uint32_t>(3, 1));
-		REQUIRE(lexer.GetNextToken().mPos == std::tuple<uint32_t, uint32_t>(5, 1));
-		REQUIRE(lexer.GetNextToken().mPos == std::tuple<uint32_t, uint32_t>(7, 1));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(1, 1));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(3, 1));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(5, 1));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(7, 1));
 		REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_EOF);
 	}
 
+	SECTION("TestGetCursorPosition_PassTokenizedStream_ReturnsPositionsOfTokensBeginnings")
+	{
+		std::unique_ptr<IInputStream> stream{ new MockInputStream {
+			{
+				"class Foo",
+				"{",
+				"\t/* comment */ int mValue;",
+				"};",
+			} } };
+
+		Lexer lexer(*stream);
+		lexer.TokenizeAll();
+
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(1, 1));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(7, 1));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(1, 2));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(16, 3));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(20, 3));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(26, 3));
+		REQUIRE(lexer.GetCursorPosition(lexer.GetNextToken().mOffset) == std::tuple<uint32_t, uint32_t>(1, 4));
+	}
+
 	SECTION("TestGetNextToken_PassMacroDefinition_EatsMacroDefinitionAndReturnsEOFToken")
 	{
 		std::unique_ptr<IInputStream> stream{ new MockInputStream {
@@ -470,6 +540,40 @@ TEST_CASE("Lexer tests")
 		}
 	}
 
+	SECTION("TestPeekToken_PeekFarTokensAndConsumeThem_GetNextTokenReturnsPeekedTokensInSameOrder")
+	{
+		std::unique_ptr<IInputStream> stream{ new MockInputStream {
+			{
+				"=,;:{}()<>|=,;:{}()<>|"
+			} } };
+
+		Lexer lexer(*stream);
+
+		std::vector<E_TOKEN_TYPE> expectedTokens;
+
+		REQUIRE(lexer.PeekToken(0).mType == E_TOKEN_TYPE::TT_ASSIGN_OP);
+
+		for (uint32_t i = 1; i < 12; ++i)
+		{
+			expectedTokens.push_back(lexer.PeekToken(i).mType);
+		}
+
+		// \note Get all peeked tokens and a few more which make the buffer wrap around
+		for (uint32_t i = 0; i < 21; ++i)
+		{
+			const E_TOKEN_TYPE expectedType = lexer.PeekToken(1).mType;
+			REQUIRE(lexer.GetNextToken().mType == expectedType);
+
+			if (i < expectedTokens.size())
+			{
+				REQUIRE(expectedType == expectedTokens[i]);
+			}
+		}
+
+		REQUIRE(lexer.GetCurrToken().mType == E_TOKEN_TYPE::TT_PIPE);
+		REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_EOF);
+	}
+
 	SECTION("TestGetCurrToken_InvokePeekTokenBeforeGetCurrToken_GetCurrTokenShouldReturnSameResultNoMatterOfPeekTokenCalls")
 	{
 		std::unique_ptr<IInputStream> stream{ new MockInputStream {
@@ -637,4 +741,233 @@ TEST_CASE("Lexer tests")
 
 		lexer.SetMetaTagParsingMode(false);
 	}
+
+	SECTION("TestGetNextToken_PassMemoryMappedFile_ReturnsSameTokensAsLineByLineStream")
+	{
+		const std::string filename = "memoryMappedInputStreamTest.h";
+		const std::vector<std::string> lines
+		{
+			"namespace A { // comment",
+			"\tenum class E_TYPE : int { FIRST, SECOND };",
+			"/* multi-line",
+			"  comment */ struct B;",
+			"}"
+		};
+
+		{
+			std::ofstream file(filename);
+
+			for (const std::string& currLine : lines)
+			{
+				file << currLine << "\n";
+			}
+		}
+
+		MemoryMappedInputStream mappedStream(filename);
+		REQUIRE(mappedStream.Open());
+		REQUIRE(!mappedStream.GetContents().empty());
+
+		MockInputStream lineStream(lines);
+
+		Lexer mappedLexer(mappedStream);
+		Lexer lineLexer(lineStream);
+
+		const TToken* pCurrToken = nullptr;
+
+		while ((pCurrToken = &mappedLexer.GetNextToken())->mType != E_TOKEN_TYPE::TT_EOF)
+		{
+			const TToken& expectedToken = lineLexer.GetNextToken();
+
+			REQUIRE(pCurrToken->mType == expectedToken.mType);
+			REQUIRE(pCurrToken->mValue == expectedToken.mValue);
+			REQUIRE(pCurrToken->mOffset == expectedToken.mOffset);
+		}
+
+		REQUIRE(lineLexer.GetNextToken().mType == E_TOKEN_TYPE::TT_EOF);
+		REQUIRE(mappedStream.Close());
+
+		std::remove(filename.c_str());
+	}
+
+	SECTION("TestHasTypesMetaMarkers_PassTextsWithAndWithoutMarkers_ReturnsTrueOnlyForTypeMarkers")
+	{
+		REQUIRE(HasTypesMetaMarkers("namespace A { class ENUM_META(SECTION=a) E_TYPE {}; }"));
+		REQUIRE(HasTypesMetaMarkers("class CLASS_META() A {};"));
+		REQUIRE(HasTypesMetaMarkers("INTERFACE_META"));
+		REQUIRE(!HasTypesMetaMarkers("class A { FIELD_META() int mValue; };"));
+		REQUIRE(!HasTypesMetaMarkers("#define TDE2_META_EXPORT\nstruct B {};"));
+		REQUIRE(!HasTypesMetaMarkers(""));
+	}
+
+	SECTION("TestTokenizeAll_SwitchModesWhileReadingTokens_ReturnsSameTokensAsStreamingLexer")
+	{
+		const std::vector<std::string> lines
+		{
+			"namespace A {",
+			"\tclass CLASS_META(SECTION=Test, name = \"B\") B: public C<D<E>> /* comment */ {",
+			"\t\tpublic: // public members",
+			"\t\t\tFIELD_META(NAME=value) std::vector<std::vector<int>> mValues = { 1 >> 2 };",
+			"BEGIN_IGNORE_META_SECTION",
+			"\t\t\tSOME_MACRO(a >> b)",
+			"END_IGNORE_META_SECTION",
+			"\t\t\tint SECTION, flags;",
+			"\t};",
+			"#define MACRO(x) \\",
+			"\tx",
+			"}"
+		};
+
+		MockInputStream streamingInput(lines);
+		MockInputStream batchInput(lines);
+
+		Lexer streamingLexer(streamingInput);
+		Lexer batchLexer(batchInput);
+
+		batchLexer.TokenizeAll();
+		REQUIRE(batchLexer.GetTokensStorage().GetSize() > 0);
+
+		uint32_t templateArgsDepth = 0;
+
+		for (uint32_t step = 0; step < 256; ++step)
+		{
+			const TToken& streamingToken = (step % 3) ? streamingLexer.GetNextToken() : streamingLexer.PeekToken(step % 4);
+			const TToken& batchToken = (step % 3) ? batchLexer.GetNextToken() : batchLexer.PeekToken(step % 4);
+
+			REQUIRE(streamingToken.mType == batchToken.mType);
+			REQUIRE(streamingToken.mValue == batchToken.mValue);
+			REQUIRE(streamingToken.mOffset == batchToken.mOffset);
+
+			// \note Switch modes in the same way as the parser does
+			switch (batchToken.mType)
+			{
+				case E_TOKEN_TYPE::TT_LESS:
+					++templateArgsDepth;
+					break;
+				case E_TOKEN_TYPE::TT_GREAT:
+					templateArgsDepth -= templateArgsDepth ? 1 : 0;
+					break;
+				case E_TOKEN_TYPE::TT_CLASS_META_ATTRIBUTE:
+				case E_TOKEN_TYPE::TT_FIELD_META_ATTRIBUTE:
+					streamingLexer.SetMetaTagParsingMode(true);
+					batchLexer.SetMetaTagParsingMode(true);
+					break;
+				case E_TOKEN_TYPE::TT_CLOSE_PARENTHES:
+					streamingLexer.SetMetaTagParsingMode(false);
+					batchLexer.SetMetaTagParsingMode(false);
+					break;
+				default:
+					break;
+			}
+
+			streamingLexer.SetTemplateArgsParsingMode(templateArgsDepth > 0);
+			batchLexer.SetTemplateArgsParsingMode(templateArgsDepth > 0);
+
+			if (E_TOKEN_TYPE::TT_EOF == batchToken.mType && (step % 3)) // \note A peeked EOF doesn't mean that all tokens were consumed
+			{
+				break;
+			}
+		}
+
+		REQUIRE(streamingLexer.GetNextToken().mType == E_TOKEN_TYPE::TT_EOF);
+		REQUIRE(batchLexer.GetNextToken().mType == E_TOKEN_TYPE::TT_EOF);
+	}
+	SECTION("TestSkipBalancedTokens_PassBodiesWithCommentsAndLiterals_SkipsToMatchingClosingToken")
+	{
+		const std::vector<std::string> lines
+		{
+			"class A {",
+			"\tvoid F() const { if (x) { g(\"}\", '{', R\"(})\"); } // }",
+			"\t\t/* } */ }",
+			"\tint G(int a = (1), char b = ')');",
+			"BEGIN_IGNORE_META_SECTION { // END_IGNORE_META_SECTION",
+			"\t\"END_IGNORE_META_SECTION\" XEND_IGNORE_META_SECTION END_IGNORE_META_SECTION",
+			"};",
+		};
+
+		for (const bool isTokenized : { false, true })
+		{
+			MockInputStream input(lines);
+
+			Lexer lexer(input);
+
+			if (isTokenized)
+			{
+				lexer.TokenizeAll();
+			}
+
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_CLASS);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_IDENTIFIER);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_OPEN_BRACE);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_VOID);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_IDENTIFIER);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_OPEN_PARENTHES);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_CLOSE_PARENTHES);
+			REQUIRE(lexer.GetNextToken().mValue == "const");
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_OPEN_BRACE);
+			REQUIRE(lexer.PeekToken(2).mIsValid); // \note Lookahead tokens shouldn't break skipping
+
+			REQUIRE(lexer.SkipBalancedTokens());
+			REQUIRE(lexer.GetCurrToken().mType == E_TOKEN_TYPE::TT_CLOSE_BRACE);
+			REQUIRE(lexer.GetCursorPosition(lexer.GetCurrToken().mOffset) == std::tuple<uint32_t, uint32_t>(11, 3));
+
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_INT);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_IDENTIFIER);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_OPEN_PARENTHES);
+
+			REQUIRE(lexer.SkipBalancedTokens());
+			REQUIRE(lexer.GetCurrToken().mType == E_TOKEN_TYPE::TT_CLOSE_PARENTHES);
+
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_SEMICOLON);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_CLOSE_BRACE);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_SEMICOLON);
+			REQUIRE(lexer.GetNextToken().mType == E_TOKEN_TYPE::TT_EOF);
+		}
+	}
+
+	SECTION("TestSkipBalancedTokens_PassUnbalancedBlock_ReturnsFalseAndEOFToken")
+	{
+		for (const bool isTokenized : { false, true })
+		{
+			MockInputStream input({ "void F() { {", "}" });
+
+			Lexer lexer(input);
+
+			if (isTokenized)
+			{
+				lexer.TokenizeAll();
+			}
+
+			while (lexer.GetNextToken().mType != E_TOKEN_TYPE::TT_OPEN_BRACE);
+
+			REQUIRE(!lexer.SkipBalancedTokens());
+			REQUIRE(lexer.GetCurrToken().mType == E_TOKEN_TYPE::TT_EOF);
+		}
+	}
+
+	SECTION("TestTokenizeAll_PassInlineMethods_StoresOnlyBracesOfBodies")
+	{
+		MockInputStream input({ "struct A { A(): mA(0) { F(1, 2); } int Get() const override { return mA; } int mA; };" });
+
+		Lexer lexer(input);
+		lexer.TokenizeAll();
+
+		const TTokensStorage& storage = lexer.GetTokensStorage();
+
+		const std::vector<E_TOKEN_TYPE> expectedTypes
+		{
+			E_TOKEN_TYPE::TT_STRUCT, E_TOKEN_TYPE::TT_IDENTIFIER, E_TOKEN_TYPE::TT_OPEN_BRACE,
+			E_TOKEN_TYPE::TT_IDENTIFIER, E_TOKEN_TYPE::TT_OPEN_PARENTHES, E_TOKEN_TYPE::TT_CLOSE_PARENTHES, E_TOKEN_TYPE::TT_COLON,
+			E_TOKEN_TYPE::TT_IDENTIFIER, E_TOKEN_TYPE::TT_OPEN_PARENTHES, E_TOKEN_TYPE::TT_NUMBER, E_TOKEN_TYPE::TT_CLOSE_PARENTHES,
+			E_TOKEN_TYPE::TT_OPEN_BRACE, E_TOKEN_TYPE::TT_CLOSE_BRACE,
+			E_TOKEN_TYPE::TT_INT, E_TOKEN_TYPE::TT_IDENTIFIER, E_TOKEN_TYPE::TT_OPEN_PARENTHES, E_TOKEN_TYPE::TT_CLOSE_PARENTHES,
+			E_TOKEN_TYPE::TT_IDENTIFIER, E_TOKEN_TYPE::TT_OVERRIDE, E_TOKEN_TYPE::TT_OPEN_BRACE, E_TOKEN_TYPE::TT_CLOSE_BRACE,
+			E_TOKEN_TYPE::TT_INT, E_TOKEN_TYPE::TT_IDENTIFIER, E_TOKEN_TYPE::TT_SEMICOLON,
+			E_TOKEN_TYPE::TT_CLOSE_BRACE, E_TOKEN_TYPE::TT_SEMICOLON, E_TOKEN_TYPE::TT_EOF,
+		};
+
+		REQUIRE(storage.mTypes == expectedTypes);
+		REQUIRE(storage.mMatchingTokenIndices[2] == 24);
+		REQUIRE(storage.mMatchingTokenIndices[11] == 12);
+		REQUIRE(storage.mMatchingTokenIndices[19] == 20);
+	}
 }
\ No newline at end of file
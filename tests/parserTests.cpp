@@ -119,7 +119,7 @@ TEST_CASE("Parser tests")
 		auto pTestEnumScope = symTable.LookUpNamedScope("TEST");
 		REQUIRE(pTestEnumScope);
 
-		TEnumType* pTypeDesc = dynamic_cast<TEnumType*>(pTestEnumScope->mpType.get());
+		TEnumType* pTypeDesc = dynamic_cast<TEnumType*>(pTestEnumScope->mpType);
 		REQUIRE((pTypeDesc && pTypeDesc->mIsMarkedWithAttribute));
 	}
 
@@ -142,7 +142,7 @@ TEST_CASE("Parser tests")
 		auto pTestEnumScope = symTable.LookUpNamedScope("TEST");
 		REQUIRE(pTestEnumScope);
 
-		TEnumType* pTypeDesc = dynamic_cast<TEnumType*>(pTestEnumScope->mpType.get());
+		TEnumType* pTypeDesc = dynamic_cast<TEnumType*>(pTestEnumScope->mpType);
 		REQUIRE(pTypeDesc);
 
 		auto&& enumerators = pTypeDesc->mEnumerators;
@@ -253,7 +253,7 @@ TEST_CASE("Parser tests")
 			auto pNestedEnumScope = symTable.LookUpNamedScope("NestedEnum");
 			REQUIRE(pNestedEnumScope);
 
-			TEnumType* pTypeDesc = dynamic_cast<TEnumType*>(pNestedEnumScope->mpType.get());
+			TEnumType* pTypeDesc = dynamic_cast<TEnumType*>(pNestedEnumScope->mpType);
 			REQUIRE((pTypeDesc && E_ACCESS_SPECIFIER_TYPE::PUBLIC == pTypeDesc->mAccessModifier));
 
 			auto&& enumerators = pTypeDesc->mEnumerators;
@@ -266,7 +266,7 @@ TEST_CASE("Parser tests")
 			auto pPrivateNestedEnum = symTable.LookUpNamedScope("Test"); 
 			REQUIRE(pPrivateNestedEnum);
 
-			pTypeDesc = dynamic_cast<TEnumType*>(pPrivateNestedEnum->mpType.get());
+			pTypeDesc = dynamic_cast<TEnumType*>(pPrivateNestedEnum->mpType);
 			REQUIRE((pTypeDesc && E_ACCESS_SPECIFIER_TYPE::PRIVATE == pTypeDesc->mAccessModifier));
 		}
 		symTable.ExitScope();
@@ -297,7 +297,7 @@ TEST_CASE("Parser tests")
 				auto pNestedEnumScope = symTable.LookUpNamedScope("NestedEnum");
 				REQUIRE(pNestedEnumScope);
 
-				TEnumType* pTypeDesc = dynamic_cast<TEnumType*>(pNestedEnumScope->mpType.get());
+				TEnumType* pTypeDesc = dynamic_cast<TEnumType*>(pNestedEnumScope->mpType);
 				REQUIRE((pTypeDesc && E_ACCESS_SPECIFIER_TYPE::PUBLIC == pTypeDesc->mAccessModifier));
 
 				auto&& enumerators = pTypeDesc->mEnumerators;
@@ -307,9 +307,9 @@ TEST_CASE("Parser tests")
 					enumerators[1] == "Second" &&
 					enumerators[2] == "Third"));
 
-				REQUIRE(pNestedEnumScope->mpParentScope);
+				REQUIRE(pNestedEnumScope->mParentIndex != SymTable::TScopeEntity::mInvalidIndex);
 
-				TClassType* pParentType = dynamic_cast<TClassType*>(pNestedEnumScope->mpParentScope->mpType.get());
+				TClassType* pParentType = dynamic_cast<TClassType*>(symTable.GetScope(pNestedEnumScope->mParentIndex).mpType);
 				REQUIRE((pParentType && pParentType->mId == "B"));
 			}
 			symTable.ExitScope();
@@ -342,7 +342,7 @@ TEST_CASE("Parser tests")
 			auto pNestedEnumScope = symTable.LookUpNamedScope("B");
 			REQUIRE(pNestedEnumScope);
 
-			auto pType = dynamic_cast<TClassType*>(pNestedEnumScope->mpType.get());
+			auto pType = dynamic_cast<TClassType*>(pNestedEnumScope->mpType);
 			REQUIRE((pType && pType->mIsTemplate));
 		}
 		symTable.ExitScope();
@@ -351,7 +351,7 @@ TEST_CASE("Parser tests")
 		auto pNestedEnumScope = symTable.LookUpNamedScope("C");
 		REQUIRE(pNestedEnumScope);
 
-		auto pType = dynamic_cast<TClassType*>(pNestedEnumScope->mpType.get());
+		auto pType = dynamic_cast<TClassType*>(pNestedEnumScope->mpType);
 		REQUIRE((pType && pType->mIsTemplate));
 	}
 
@@ -377,7 +377,7 @@ TEST_CASE("Parser tests")
 
 		REQUIRE(symTable.EnterScope("Position"));
 		{
-			TClassType::Ptr pType = std::dynamic_pointer_cast<TClassType>(symTable.GetCurrScopeType());
+			TClassType* pType = dynamic_cast<TClassType*>(symTable.GetCurrScopeType());
 			REQUIRE(pType);
 
 			REQUIRE(pType->mFields.size() == 3);
@@ -390,7 +390,7 @@ TEST_CASE("Parser tests")
 
 		REQUIRE(symTable.EnterScope("Identifier"));
 		{
-			TClassType::Ptr pType = std::dynamic_pointer_cast<TClassType>(symTable.GetCurrScopeType());
+			TClassType* pType = dynamic_cast<TClassType*>(symTable.GetCurrScopeType());
 			REQUIRE(pType);
 
 			REQUIRE(pType->mFields.size() == 1);
@@ -419,7 +419,7 @@ TEST_CASE("Parser tests")
 
 		REQUIRE(symTable.EnterScope("Tag"));
 		{
-			TClassType::Ptr pType = std::dynamic_pointer_cast<TClassType>(symTable.GetCurrScopeType());
+			TClassType* pType = dynamic_cast<TClassType*>(symTable.GetCurrScopeType());
 			REQUIRE(pType);
 
 			REQUIRE(pType->mFields.size() == 1);
@@ -459,7 +459,7 @@ TEST_CASE("Parser tests")
 		{
 			REQUIRE(symTable.EnterScope("E_ANIMATION_WRAP_MODE_TYPE"));
 			
-			TEnumType::Ptr pType = std::dynamic_pointer_cast<TEnumType>(symTable.GetCurrScopeType());
+			TEnumType* pType = dynamic_cast<TEnumType*>(symTable.GetCurrScopeType());
 			REQUIRE(pType);
 
 			symTable.ExitScope();
@@ -486,13 +486,13 @@ TEST_CASE("Parser tests")
 		auto pTestStructScope = symTable.LookUpNamedScope("TestType");
 		REQUIRE(pTestStructScope);
 
-		TClassType::Ptr pTypeDesc = std::dynamic_pointer_cast<TClassType>(pTestStructScope->mpType);
+		TClassType* pTypeDesc = dynamic_cast<TClassType*>(pTestStructScope->mpType);
 		REQUIRE((pTypeDesc && pTypeDesc->mIsMarkedWithAttribute));
 
 		auto pTestStructWithSectionScope = symTable.LookUpNamedScope("TestTypeWithSection");
 		REQUIRE(pTestStructWithSectionScope);
 
-		TClassType::Ptr pTypeWithSectionDesc = std::dynamic_pointer_cast<TClassType>(pTestStructWithSectionScope->mpType);
+		TClassType* pTypeWithSectionDesc = dynamic_cast<TClassType*>(pTestStructWithSectionScope->mpType);
 		REQUIRE((pTypeWithSectionDesc && pTypeWithSectionDesc->mIsMarkedWithAttribute && pTypeWithSectionDesc->mAttributes.mSectionId == "test_section"));
 	}
 
@@ -518,10 +518,10 @@ TEST_CASE("Parser tests")
 		auto pClassBScope = symTable.LookUpNamedScope("B");
 		REQUIRE(pClassBScope);
 
-		TClassType::Ptr pTypeADesc = std::dynamic_pointer_cast<TClassType>(pClassAScope->mpType);
+		TClassType* pTypeADesc = dynamic_cast<TClassType*>(pClassAScope->mpType);
 		REQUIRE(pTypeADesc);
 
-		TClassType::Ptr pTypeBDesc = std::dynamic_pointer_cast<TClassType>(pClassBScope->mpType);
+		TClassType* pTypeBDesc = dynamic_cast<TClassType*>(pClassBScope->mpType);
 		REQUIRE((pTypeBDesc && pTypeBDesc->mBaseClasses.size() == 1 && pTypeBDesc->mBaseClasses.front().mFullName == "::A"));
 	}
 
@@ -547,10 +547,10 @@ TEST_CASE("Parser tests")
 		auto pClassBScope = symTable.LookUpNamedScope("B");
 		REQUIRE(pClassBScope);
 
-		TClassType::Ptr pTypeADesc = std::dynamic_pointer_cast<TClassType>(pClassAScope->mpType);
+		TClassType* pTypeADesc = dynamic_cast<TClassType*>(pClassAScope->mpType);
 		REQUIRE(pTypeADesc);
 
-		TClassType::Ptr pTypeBDesc = std::dynamic_pointer_cast<TClassType>(pClassBScope->mpType);
+		TClassType* pTypeBDesc = dynamic_cast<TClassType*>(pClassBScope->mpType);
 		REQUIRE((pTypeBDesc && pTypeBDesc->mBaseClasses.size() == 1 && pTypeBDesc->mBaseClasses.front().mFullName == "A<B>::C"));
 	}
 
@@ -572,7 +572,7 @@ TEST_CASE("Parser tests")
 		auto pTestClassScope = symTable.LookUpNamedScope("Test");
 		REQUIRE(pTestClassScope);
 
-		TClassType::Ptr pTestTypeDesc = std::dynamic_pointer_cast<TClassType>(pTestClassScope->mpType);
+		TClassType* pTestTypeDesc = dynamic_cast<TClassType*>(pTestClassScope->mpType);
 		REQUIRE((pTestTypeDesc && pTestTypeDesc->mAttributes.mSectionId == "TestSection"));
 
 		E_SERIALIZATION_ATTRIBUTES_FLAGS flags = pTestTypeDesc->mAttributes.mFlags;
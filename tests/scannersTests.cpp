@@ -0,0 +1,175 @@
+#include <vector>
+#include <string>
+#include <random>
+#include <scanners.h>
+#include <tokens.h>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace TDEngine2;
+
+
+static const std::vector<E_SIMD_INSTRUCTIONS_SET> InstructionsSets
+{
+	E_SIMD_INSTRUCTIONS_SET::NONE,
+	E_SIMD_INSTRUCTIONS_SET::SSE2,
+	E_SIMD_INSTRUCTIONS_SET::AVX2,
+};
+
+
+static size_t Scan(TScanFunction pScanFunction, const std::string& text, size_t startPos = 0)
+{
+	return static_cast<size_t>(pScanFunction(text.data() + startPos, text.data() + text.size()) - text.data());
+}
+
+
+TEST_CASE("Scanners tests")
+{
+	SECTION("TestSkipWhitespaces_PassWhitespacesRuns_ReturnsFirstNonWhitespace")
+	{
+		const std::string text = std::string(40, ' ') + "\t\t\r\n\v\f" + std::string(20, ' ') + "a" + std::string(50, '\t') + "\nb";
+
+		for (E_SIMD_INSTRUCTIONS_SET currSet : InstructionsSets)
+		{
+			const TTextScannersTable& scanners = GetTextScanners(currSet);
+
+			REQUIRE(Scan(scanners.mpSkipWhitespaces, text) == 66);
+			REQUIRE(Scan(scanners.mpSkipWhitespaces, text, 67) == text.size() - 1);
+			REQUIRE(Scan(scanners.mpSkipWhitespaces, text, text.size()) == text.size());
+		}
+	}
+
+	SECTION("TestFindLineEnd_PassLongComment_ReturnsPositionOfNewLineOrEnd")
+	{
+		const std::string text = "/// \\brief The method does something useful with all the given arguments\nnext";
+
+		for (E_SIMD_INSTRUCTIONS_SET currSet : InstructionsSets)
+		{
+			const TTextScannersTable& scanners = GetTextScanners(currSet);
+
+			REQUIRE(Scan(scanners.mpFindLineEnd, text) == text.find('\n'));
+			REQUIRE(Scan(scanners.mpFindLineEnd, text, text.find('\n') + 1) == text.size());
+		}
+	}
+
+	SECTION("TestFindCommentDelimiter_PassMultiLineComment_SkipsNewLinesAndReturnsPositionOfEachDelimiter")
+	{
+		const std::string text = "/*!\n\t\\brief The long enough description of the type that contains no delimiters\n*/";
+
+		for (E_SIMD_INSTRUCTIONS_SET currSet : InstructionsSets)
+		{
+			const TTextScannersTable& scanners = GetTextScanners(currSet);
+
+			REQUIRE(Scan(scanners.mpFindCommentDelimiter, text, 1) == 1);
+			REQUIRE(Scan(scanners.mpFindCommentDelimiter, text, 2) == text.size() - 2);
+			REQUIRE(Scan(scanners.mpFindCommentDelimiter, text, text.size() - 2) == text.size() - 2);
+		}
+	}
+
+	SECTION("TestFindIdentifierEnd_PassIdentifiers_ReturnsPositionOfFirstNonIdentifierChar")
+	{
+		const std::string text = "SERIALIZE_MARKED_ONLY_FIELDS_abcdefghijklmnopqrstuvwxyz_0123456789 = mValue;";
+
+		for (E_SIMD_INSTRUCTIONS_SET currSet : InstructionsSets)
+		{
+			const TTextScannersTable& scanners = GetTextScanners(currSet);
+
+			REQUIRE(Scan(scanners.mpFindIdentifierEnd, text) == text.find(' '));
+			REQUIRE(Scan(scanners.mpFindIdentifierEnd, text, text.rfind('m')) == text.size() - 1);
+		}
+	}
+
+	SECTION("TestFindBalancedTextDelimiter_PassFunctionBody_ReturnsPositionOfEachDelimiter")
+	{
+		const std::string text = "{ return mValue + GetOtherValue + 1 * 2 - 3 ^ 4 | 5 & 6 == ~7 % 8 ? x : y[z]; } // ( \" ' #";
+
+		for (E_SIMD_INSTRUCTIONS_SET currSet : InstructionsSets)
+		{
+			const TTextScannersTable& scanners = GetTextScanners(currSet);
+
+			size_t pos = Scan(scanners.mpFindBalancedTextDelimiter, text);
+			REQUIRE(pos == 0);
+
+			for (const char expectedChar : std::string("}//(\"'#"))
+			{
+				pos = Scan(scanners.mpFindBalancedTextDelimiter, text, pos + 1);
+				REQUIRE(text[pos] == expectedChar);
+			}
+
+			REQUIRE(Scan(scanners.mpFindBalancedTextDelimiter, text, pos + 1) == text.size());
+		}
+	}
+
+	SECTION("TestFindSubstring_PassTextWithPatternNearTheEnd_ReturnsPositionOfPattern")
+	{
+		const std::string text = std::string(100, '_') + "META_ENUM_META" + std::string(3, ' ');
+		const std::string pattern = "_META";
+
+		for (E_SIMD_INSTRUCTIONS_SET currSet : InstructionsSets)
+		{
+			const TTextScannersTable& scanners = GetTextScanners(currSet);
+
+			REQUIRE(scanners.mpFindSubstring(text.data(), text.data() + text.size(), pattern.data(), pattern.size()) - text.data() == 99);
+			REQUIRE(scanners.mpFindSubstring(text.data() + 100, text.data() + text.size(), pattern.data(), pattern.size()) - text.data() == 109);
+			REQUIRE(scanners.mpFindSubstring(text.data() + 110, text.data() + text.size(), pattern.data(), pattern.size()) == text.data() + text.size());
+		}
+	}
+
+	SECTION("TestScanners_PassRandomText_AllImplementationsReturnSameResults")
+	{
+		static const std::string alphabet = " \t\r\n/*_aZz09@`[{}()#\"'\x80\xff";
+
+		std::mt19937 randomGenerator(42);
+		std::uniform_int_distribution<size_t> charsDistribution(0, alphabet.size() - 1);
+
+		std::string text(4096, ' ');
+
+		for (char& currChar : text)
+		{
+			currChar = alphabet[charsDistribution(randomGenerator)];
+		}
+
+		const TTextScannersTable& scalarScanners = GetTextScanners(E_SIMD_INSTRUCTIONS_SET::NONE);
+
+		for (E_SIMD_INSTRUCTIONS_SET currSet : InstructionsSets)
+		{
+			const TTextScannersTable& scanners = GetTextScanners(currSet);
+
+			for (size_t pos = 0; pos < text.size(); ++pos)
+			{
+				REQUIRE(Scan(scanners.mpSkipWhitespaces, text, pos) == Scan(scalarScanners.mpSkipWhitespaces, text, pos));
+				REQUIRE(Scan(scanners.mpFindLineEnd, text, pos) == Scan(scalarScanners.mpFindLineEnd, text, pos));
+				REQUIRE(Scan(scanners.mpFindCommentDelimiter, text, pos) == Scan(scalarScanners.mpFindCommentDelimiter, text, pos));
+				REQUIRE(Scan(scanners.mpFindIdentifierEnd, text, pos) == Scan(scalarScanners.mpFindIdentifierEnd, text, pos));
+				REQUIRE(Scan(scanners.mpFindBalancedTextDelimiter, text, pos) == Scan(scalarScanners.mpFindBalancedTextDelimiter, text, pos));
+				REQUIRE(scanners.mpFindSubstring(text.data() + pos, text.data() + text.size(), "*_a", 3) == 
+						scalarScanners.mpFindSubstring(text.data() + pos, text.data() + text.size(), "*_a", 3));
+			}
+		}
+	}
+
+	SECTION("TestCharClassesTable_PassAllCharacters_PunctuatorsAndIdentifiersClassesMatchLexerRules")
+	{
+		for (uint32_t i = 0; i < 256; ++i)
+		{
+			const char ch = static_cast<char>(i);
+			const E_CHAR_CLASS charClass = GetCharClass(ch);
+
+			const bool isPunctuatorStart = E_TOKEN_TYPE::TT_UNKNOWN != GetPunctuatorTokenType(std::string_view(&ch, 1)) || ch == '-' || ch == '+';
+			REQUIRE(isPunctuatorStart == (E_CHAR_CLASS::PUNCTUATOR == charClass));
+
+			const bool isIdentifierStart = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+			REQUIRE(isIdentifierStart == IsIdentifierStartChar(ch));
+			REQUIRE((isIdentifierStart || (ch >= '0' && ch <= '9')) == IsIdentifierChar(ch));
+		}
+
+		REQUIRE(GetCharClass('\xff') == E_CHAR_CLASS::OTHER);
+		REQUIRE(GetCharClass('R') == E_CHAR_CLASS::LITERAL_PREFIX);
+	}
+
+	SECTION("TestGetTextScanners_RequestUnsupportedSet_ReturnsKernelsThatCanBeExecuted")
+	{
+		REQUIRE(GetTextScanners().mInstructionsSet == GetSupportedInstructionsSet());
+		REQUIRE(GetTextScanners(E_SIMD_INSTRUCTIONS_SET::AVX2).mInstructionsSet <= GetSupportedInstructionsSet());
+	}
+}
@@ -1,8 +1,8 @@
 #include <symtable.h>
 #include <common.h>
-#include "../deps/archive/archive.h"
+#include <bufferarchive.h>
+#include <lexer.h>
 #include <catch2/catch_test_macros.hpp>
-#include <fstream>
 
 
 using namespace TDEngine2;
@@ -20,34 +20,38 @@ TEST_CASE("Serialization tests")
 
 		// Serialization
 		{
-			std::unique_ptr<TEnumType> pType = std::make_unique<TEnumType>();
-			pType->mId = enumName;
+			SymTable symTable;
+			TEnumType* pType = symTable.CreateType<TEnumType>();
+			pType->mId = InternString(enumName);
 			pType->mIsIntrospectable = true;
 			pType->mEnumerators.push_back("FIRST");
 			pType->mEnumerators.push_back("SECOND");
 			pType->mEnumerators.push_back("THIRD");
 			pType->mEnumerators.push_back("RV_UNRECOGNIZED_TOKENS_SEQ");
 
-			std::ofstream outfile(filename, std::ios::binary);
-			Archive<std::ofstream> archive(outfile);
+			BufferWriterArchive archive;
 
 			REQUIRE(pType->Save(archive));
 
-			outfile.close();
+			REQUIRE(archive.SaveToFile(filename));
 		}
 		
 		// Deserialization
 		{
-			std::ifstream infile(filename, std::ios::binary);
-			Archive<std::ifstream> archive(infile);
+			MemoryMappedInputStream infile(filename);
+			REQUIRE(infile.Open());
 
-			std::unique_ptr<TType> pType = TType::Deserialize(archive);
+			BufferReaderArchive archive(infile.GetContents());
+
+			SymTable symTable;
+
+			TType* pType = TType::Deserialize(archive, symTable);
 			REQUIRE(pType);
 
-			TEnumType* pEnumType = dynamic_cast<TEnumType*>(pType.get());
+			TEnumType* pEnumType = dynamic_cast<TEnumType*>(pType);
 			REQUIRE((pEnumType && pEnumType->mId == enumName && pEnumType->mEnumerators.size() == 4));
 
-			infile.close();
+			infile.Close();
 		}		
 	}
 
@@ -57,29 +61,33 @@ TEST_CASE("Serialization tests")
 
 		// Serialization
 		{
-			std::unique_ptr<TClassType> pType = std::make_unique<TClassType>();
-			pType->mId = className;
+			SymTable symTable;
+			TClassType* pType = symTable.CreateType<TClassType>();
+			pType->mId = InternString(className);
 			pType->mIsFinal = true;
-			pType->mBaseClasses.push_back({ "A" });
-			pType->mBaseClasses.push_back({ "B" });
+			pType->mBaseClasses.push_back({ InternString("A") });
+			pType->mBaseClasses.push_back({ InternString("B") });
 
-			std::ofstream outfile(TestSerializationFilename);
-			Archive<std::ofstream> archive(outfile);
+			BufferWriterArchive archive;
 
 			REQUIRE(pType->Save(archive));
 
-			outfile.close();
+			REQUIRE(archive.SaveToFile(TestSerializationFilename));
 		}
 
 		// Deserialization
 		{
-			std::ifstream infile(TestSerializationFilename);
-			Archive<std::ifstream> archive(infile);
+			MemoryMappedInputStream infile(TestSerializationFilename);
+			REQUIRE(infile.Open());
+
+			BufferReaderArchive archive(infile.GetContents());
 
-			std::unique_ptr<TType> pType = TType::Deserialize(archive);
+			SymTable symTable;
+
+			TType* pType = TType::Deserialize(archive, symTable);
 			REQUIRE(pType);
 
-			TClassType* pClassType = dynamic_cast<TClassType*>(pType.get());
+			TClassType* pClassType = dynamic_cast<TClassType*>(pType);
 			REQUIRE((pClassType && pClassType->mId == className && pClassType->mBaseClasses.size() == 2));
 			
 			if (pClassType)
@@ -88,7 +96,7 @@ TEST_CASE("Serialization tests")
 				REQUIRE(pClassType->mBaseClasses[1].mFullName == "B");
 			}
 
-			infile.close();
+			infile.Close();
 		}
 	}
 
@@ -98,29 +106,33 @@ TEST_CASE("Serialization tests")
 
 		// Serialization
 		{
-			std::unique_ptr<TNamespaceType> pType = std::make_unique<TNamespaceType>();
-			pType->mId = namespaceName;
+			SymTable symTable;
+			TNamespaceType* pType = symTable.CreateType<TNamespaceType>();
+			pType->mId = InternString(namespaceName);
 
-			std::ofstream outfile(TestSerializationFilename);
-			Archive<std::ofstream> archive(outfile);
+			BufferWriterArchive archive;
 
 			REQUIRE(pType->Save(archive));
 
-			outfile.close();
+			REQUIRE(archive.SaveToFile(TestSerializationFilename));
 		}
 
 		// Deserialization
 		{
-			std::ifstream infile(TestSerializationFilename);
-			Archive<std::ifstream> archive(infile);
+			MemoryMappedInputStream infile(TestSerializationFilename);
+			REQUIRE(infile.Open());
+
+			BufferReaderArchive archive(infile.GetContents());
 
-			std::unique_ptr<TType> pType = TType::Deserialize(archive);
+			SymTable symTable;
+
+			TType* pType = TType::Deserialize(archive, symTable);
 			REQUIRE(pType);
 
-			TNamespaceType* pNamespaceType = dynamic_cast<TNamespaceType*>(pType.get());
+			TNamespaceType* pNamespaceType = dynamic_cast<TNamespaceType*>(pType);
 			REQUIRE((pNamespaceType && pNamespaceType->mId == namespaceName));
 
-			infile.close();
+			infile.Close();
 		}
 	}
 
@@ -128,23 +140,26 @@ TEST_CASE("Serialization tests")
 	{
 		// Serialization
 		{
-			std::ofstream outfile(TestSerializationFilename);
-			Archive<std::ofstream> archive(outfile);
+			BufferWriterArchive archive;
 
 			REQUIRE(TType::SafeSerialize(archive, nullptr));
 
-			outfile.close();
+			REQUIRE(archive.SaveToFile(TestSerializationFilename));
 		}
 
 		// Deserialization
 		{
-			std::ifstream infile(TestSerializationFilename);
-			Archive<std::ifstream> archive(infile);
+			MemoryMappedInputStream infile(TestSerializationFilename);
+			REQUIRE(infile.Open());
+
+			BufferReaderArchive archive(infile.GetContents());
 
-			std::unique_ptr<TType> pType = TType::Deserialize(archive);
+			SymTable symTable;
+
+			TType* pType = TType::Deserialize(archive, symTable);
 			REQUIRE(!pType);
 
-			infile.close();
+			infile.Close();
 		}
 	}
 
@@ -152,84 +167,102 @@ TEST_CASE("Serialization tests")
 	{
 		// Serialization
 		{
-			std::unique_ptr<SymTable::TScopeEntity> pScope = std::make_unique<SymTable::TScopeEntity>();
-			pScope->mIndex = 2;
-			pScope->mVariables.push_back({ "a" });
-			pScope->mVariables.push_back({ "b" });
+			SymTable::TScopeEntity scope;
+			scope.mIndex = 2;
+			scope.mParentIndex = 1;
+			scope.mVariables.push_back({ "a" });
+			scope.mVariables.push_back({ "b" });
 
-			std::ofstream outfile(TestSerializationFilename);
-			Archive<std::ofstream> archive(outfile);
+			BufferWriterArchive archive;
 
-			REQUIRE(pScope->Save(archive));
+			REQUIRE(scope.Save(archive));
 
-			outfile.close();
+			REQUIRE(archive.SaveToFile(TestSerializationFilename));
 		}
 
 		// Deserialization
 		{
-			std::ifstream infile(TestSerializationFilename);
-			Archive<std::ifstream> archive(infile);
+			MemoryMappedInputStream infile(TestSerializationFilename);
+			REQUIRE(infile.Open());
+
+			BufferReaderArchive archive(infile.GetContents());
 
-			std::unique_ptr<SymTable::TScopeEntity> pScope = std::make_unique<SymTable::TScopeEntity>();
-			REQUIRE(pScope->Load(archive, nullptr));
+			SymTable symTable;
 
-			REQUIRE(pScope->mIndex == 2);
-			REQUIRE(pScope->mVariables.size() == 2);
-			REQUIRE(pScope->mVariables[0].mName == "a");
-			REQUIRE(pScope->mVariables[1].mName == "b");
-			REQUIRE(pScope->mpNamedScopes.empty());
-			REQUIRE(pScope->mpNestedScopes.empty());
+			SymTable::TScopeEntity scope;
+			REQUIRE(scope.Load(archive, symTable));
 
-			infile.close();
+			REQUIRE(scope.mIndex == 2);
+			REQUIRE(scope.mParentIndex == 1);
+			REQUIRE(scope.mVariables.size() == 2);
+			REQUIRE(scope.mVariables[0].mName == "a");
+			REQUIRE(scope.mVariables[1].mName == "b");
+			REQUIRE(!scope.IsNamed());
+
+			infile.Close();
 		}
 	}
 
-	SECTION("TestComplexScopeEntitySerializationDeserialization")
+	SECTION("TestSymTableSerializationDeserialization")
 	{
 		// Serialization
 		{
-			std::unique_ptr<SymTable::TScopeEntity> pScope = std::make_unique<SymTable::TScopeEntity>();
-			pScope->mIndex = 2;
-			pScope->mVariables.push_back({ "a" });
-			pScope->mVariables.push_back({ "b" });
-			pScope->mpNamedScopes["A"] = std::make_unique<SymTable::TScopeEntity>();
-			pScope->mpNamedScopes["A"]->mIndex = 0;
-			pScope->mpNamedScopes["A"]->mVariables.push_back({ "c" });
-			pScope->mpNamedScopes["A"]->mVariables.push_back({ "d" });
+			SymTable symTable;
+
+			symTable.AddSymbol({ "a" });
+			symTable.AddSymbol({ "b" });
+
+			symTable.CreateScope();
+			symTable.ExitScope();
+
+			symTable.CreateScope("A");
+			symTable.AddSymbol({ "c" });
+			symTable.AddSymbol({ "d" });
+			symTable.ExitScope();
 
-			std::ofstream outfile(TestSerializationFilename);
-			Archive<std::ofstream> archive(outfile);
+			BufferWriterArchive archive;
 
-			REQUIRE(pScope->Save(archive));
+			REQUIRE(symTable.Save(archive));
 
-			outfile.close();
+			REQUIRE(archive.SaveToFile(TestSerializationFilename));
 		}
 
 		// Deserialization
 		{
-			std::ifstream infile(TestSerializationFilename);
-			Archive<std::ifstream> archive(infile);
+			MemoryMappedInputStream infile(TestSerializationFilename);
+			REQUIRE(infile.Open());
+
+			BufferReaderArchive archive(infile.GetContents());
+
+			SymTable symTable;
+			REQUIRE(symTable.Load(archive));
+
+			REQUIRE(symTable.GetScopesCount() == 3);
+
+			const SymTable::TScopeEntity& globalScope = symTable.GetScope(0);
 
-			std::unique_ptr<SymTable::TScopeEntity> pScope = std::make_unique<SymTable::TScopeEntity>();
-			REQUIRE(pScope->Load(archive, nullptr));
+			REQUIRE(globalScope.mVariables.size() == 2);
+			REQUIRE(globalScope.mVariables[0].mName == "a");
+			REQUIRE(globalScope.mVariables[1].mName == "b");
+			REQUIRE(globalScope.mAnonymousScopesCount == 1);
 
-			REQUIRE(pScope->mIndex == 2);
-			REQUIRE(pScope->mVariables.size() == 2);
-			REQUIRE(pScope->mVariables[0].mName == "a");
-			REQUIRE(pScope->mVariables[1].mName == "b");
-			REQUIRE(pScope->mpNamedScopes.size() == 1);
-			REQUIRE(pScope->mpNestedScopes.empty());
+			const SymTable::TScopeEntity& anonymousScope = symTable.GetScope(globalScope.mFirstChildIndex);
+			REQUIRE(anonymousScope.mIndex == 0);
+			REQUIRE(!anonymousScope.IsNamed());
 
-			SymTable::TScopeEntity* pNestedScope = pScope->mpNamedScopes["A"].get();
+			SymTable::TScopeEntity* pNestedScope = symTable.LookUpNamedScope("A");
+			REQUIRE(pNestedScope);
+			REQUIRE(pNestedScope == &symTable.GetScope(anonymousScope.mNextSiblingIndex));
 
-			REQUIRE(pNestedScope->mIndex == 0);
+			REQUIRE(pNestedScope->mIndex == -1);
+			REQUIRE(pNestedScope->mName == "A");
 			REQUIRE(pNestedScope->mVariables.size() == 2);
 			REQUIRE(pNestedScope->mVariables[0].mName == "c");
 			REQUIRE(pNestedScope->mVariables[1].mName == "d");
-			REQUIRE(pNestedScope->mpNamedScopes.empty());
-			REQUIRE(pNestedScope->mpNestedScopes.empty());
+			REQUIRE(pNestedScope->mFirstChildIndex == SymTable::TScopeEntity::mInvalidIndex);
+			REQUIRE(pNestedScope->mNextSiblingIndex == SymTable::TScopeEntity::mInvalidIndex);
 
-			infile.close();
+			infile.Close();
 		}
 	}
 }
@@ -0,0 +1,81 @@
+#include <stringpool.h>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+#include <string>
+
+
+using namespace TDEngine2;
+
+
+TEST_CASE("StringPool tests")
+{
+	SECTION("TestIntern_PassEqualStrings_ReturnsSameAtoms")
+	{
+		const std::string firstStr = "TDEngine2";
+		const std::string secondStr = "TDEngine2";
+
+		TAtom firstAtom = InternString(firstStr);
+		TAtom secondAtom = InternString(secondStr);
+
+		REQUIRE(firstAtom == secondAtom);
+		REQUIRE(firstAtom != InternString("TDEngine3"));
+		REQUIRE(firstAtom == "TDEngine2");
+		REQUIRE(firstAtom.GetString().data() == secondAtom.GetString().data());
+	}
+
+	SECTION("TestIntern_PassEmptyString_ReturnsEmptyAtom")
+	{
+		TAtom atom = InternString("");
+
+		REQUIRE(atom.IsEmpty());
+		REQUIRE(atom.GetString().empty());
+		REQUIRE(atom == TAtom{});
+	}
+
+	SECTION("TestFind_PassUnknownString_ReturnsEmptyAtomAndDoesntChangeThePool")
+	{
+		const size_t size = StringPool::Get().GetSize();
+
+		REQUIRE(StringPool::Get().Find("__UnknownStringPoolTestsIdentifier__").IsEmpty());
+		REQUIRE(StringPool::Get().GetSize() == size);
+
+		TAtom atom = InternString("__KnownStringPoolTestsIdentifier__");
+		REQUIRE(StringPool::Get().Find("__KnownStringPoolTestsIdentifier__") == atom);
+	}
+
+	SECTION("TestIntern_InternSameStringsFromMultipleThreads_AllThreadsGetSameAtoms")
+	{
+		constexpr uint32_t threadsCount = 4;
+		constexpr uint32_t stringsCount = 1000;
+
+		std::vector<std::vector<TAtom>> atomsPerThread(threadsCount);
+		std::vector<std::thread> threads;
+
+		for (uint32_t i = 0; i < threadsCount; ++i)
+		{
+			threads.emplace_back([i, &atomsPerThread]
+			{
+				for (uint32_t j = 0; j < stringsCount; ++j)
+				{
+					atomsPerThread[i].push_back(InternString("Identifier" + std::to_string(j)));
+				}
+			});
+		}
+
+		for (auto&& currThread : threads)
+		{
+			currThread.join();
+		}
+
+		for (uint32_t i = 1; i < threadsCount; ++i)
+		{
+			REQUIRE(atomsPerThread[i] == atomsPerThread[0]);
+		}
+
+		for (uint32_t j = 0; j < stringsCount; ++j)
+		{
+			REQUIRE(atomsPerThread[0][j] == "Identifier" + std::to_string(j));
+		}
+	}
+}
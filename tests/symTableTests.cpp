@@ -58,4 +58,76 @@ TEST_CASE("SymTable tests")
 		REQUIRE(symTable.LookUpSymbol("x") != TSymbolDesc::mInvalid);
 		symTable.ExitScope();
 	}
+
+	SECTION("TestLookUpNamedScope_PassScopesWithSameNamesUnderDifferentParents_ReturnsTheClosestOne")
+	{
+		SymTable symTable;
+
+		symTable.CreateScope("Inner");
+		symTable.ExitScope();
+
+		symTable.CreateScope("Outer");
+		symTable.CreateScope("Inner");
+		symTable.ExitScope();
+
+		const SymTable::TScopeEntity* pInnerScope = symTable.LookUpNamedScope("Inner");
+		REQUIRE(pInnerScope);
+		REQUIRE(symTable.GetScope(pInnerScope->mParentIndex).mName == "Outer");
+
+		symTable.ExitScope();
+
+		pInnerScope = symTable.LookUpNamedScope("Inner");
+		REQUIRE(pInnerScope);
+		REQUIRE(pInnerScope->mParentIndex == 0);
+
+		REQUIRE(!symTable.CreateScope("Outer")); // \note Named scopes are unique within their parent
+		REQUIRE(symTable.GetScopesCount() == 4);
+	}
+
+	SECTION("TestAddSymbol_PassManySymbols_LookUpsAndUpdatesWorkAfterIndexIsBuilt")
+	{
+		SymTable symTable;
+
+		constexpr uint32_t symbolsCount = 1000;
+
+		for (uint32_t i = 0; i < symbolsCount; ++i)
+		{
+			symTable.AddSymbol({ "symbol" + std::to_string(i), {} });
+
+			if (i % 100 == 0) // \note Interleave lookups with inserts to check incremental updates of the index
+			{
+				REQUIRE(symTable.LookUpSymbol("symbol" + std::to_string(i / 2)) != TSymbolDesc::mInvalid);
+			}
+		}
+
+		TClassType* pType = symTable.CreateType<TClassType>();
+		symTable.AddSymbol({ "symbol500", pType });
+
+		const SymTable::TScopeEntity& globalScope = symTable.GetScope(0);
+		REQUIRE(globalScope.mVariables.size() == symbolsCount);
+		REQUIRE(globalScope.mVariables[500].mpType == pType);
+
+		for (uint32_t i = 0; i < symbolsCount; ++i)
+		{
+			REQUIRE(globalScope.mVariables[i].mName == "symbol" + std::to_string(i)); // \note The insertion order is preserved
+			REQUIRE(&symTable.LookUpSymbol("symbol" + std::to_string(i)) == &globalScope.mVariables[i]);
+		}
+
+		REQUIRE(symTable.LookUpSymbol("symbol1000") == TSymbolDesc::mInvalid);
+	}
+
+	SECTION("TestGetMangledNameForNamedScope_PassNestedScopes_AnonymousScopesAreSkipped")
+	{
+		SymTable symTable;
+
+		symTable.CreateScope("TDEngine2");
+		symTable.CreateScope();
+		symTable.CreateScope("TClass");
+		symTable.CreateScope("E_TYPE");
+
+		REQUIRE(symTable.GetMangledNameForNamedScope("E_TYPE") == "TDEngine2@TClass@E_TYPE");
+		REQUIRE(symTable.GetMangledNameForNamedScope("TClass") == "TDEngine2@TClass");
+		REQUIRE(symTable.GetMangledNameForNamedScope("TDEngine2") == "TDEngine2");
+		REQUIRE(symTable.GetMangledNameForNamedScope("Unknown").IsEmpty());
+	}
 }
@@ -0,0 +1,195 @@
+#include <symtableview.h>
+#include <cachepack.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+
+
+using namespace TDEngine2;
+
+
+static void CreateTestTypes(SymTable& symTable)
+{
+	symTable.SetSourceFilename("test.h");
+
+	symTable.CreateScope("TestClass");
+	symTable.ExitScope();
+
+	TClassType* pClassType = symTable.CreateType<TClassType>();
+	pClassType->mId = InternString("TestClass");
+	pClassType->mMangledId = symTable.LookUpNamedScope("TestClass")->mMangledId;
+	pClassType->mIsStruct = true;
+	pClassType->mAttributes.mSectionId = "common";
+	pClassType->mBaseClasses.push_back({ InternString("Base"), true, E_ACCESS_SPECIFIER_TYPE::PUBLIC });
+	pClassType->mFields.push_back({ "mValue", InternString("mValue"), true });
+	symTable.SetScopeType(*symTable.LookUpNamedScope("TestClass"), pClassType);
+
+	symTable.EnterScope("TestClass");
+	{
+		symTable.CreateScope("NestedEnum");
+		symTable.ExitScope();
+
+		TEnumType* pEnumType = symTable.CreateType<TEnumType>();
+		pEnumType->mId = InternString("NestedEnum");
+		pEnumType->mMangledId = symTable.LookUpNamedScope("NestedEnum")->mMangledId;
+		pEnumType->mIsStronglyTyped = true;
+		pEnumType->mUnderlyingTypeStr = "uint8_t";
+		pEnumType->mEnumerators = { "FIRST", "SECOND" };
+		pEnumType->mpParentType = pClassType;
+		symTable.SetScopeType(*symTable.LookUpNamedScope("NestedEnum"), pEnumType);
+	}
+	symTable.ExitScope();
+
+	symTable.CreateScope("HiddenClass");
+	symTable.ExitScope();
+
+	TClassType* pHiddenClassType = symTable.CreateType<TClassType>();
+	pHiddenClassType->mId = InternString("HiddenClass");
+	pHiddenClassType->mMangledId = symTable.LookUpNamedScope("HiddenClass")->mMangledId;
+	pHiddenClassType->mAccessModifier = E_ACCESS_SPECIFIER_TYPE::PROTECTED;
+	symTable.SetScopeType(*symTable.LookUpNamedScope("HiddenClass"), pHiddenClassType);
+
+	symTable.EnterScope("HiddenClass");
+	{
+		symTable.CreateScope("NestedClass");
+		symTable.ExitScope();
+
+		TClassType* pNestedClassType = symTable.CreateType<TClassType>();
+		pNestedClassType->mId = InternString("NestedClass");
+		pNestedClassType->mMangledId = symTable.LookUpNamedScope("NestedClass")->mMangledId;
+		pNestedClassType->mpParentType = pHiddenClassType;
+		symTable.SetScopeType(*symTable.LookUpNamedScope("NestedClass"), pNestedClassType);
+	}
+	symTable.ExitScope();
+}
+
+
+TEST_CASE("SymTableView tests")
+{
+	SECTION("TestInit_PassBuiltData_ViewContainsAllTypes")
+	{
+		SymTable symTable;
+		CreateTestTypes(symTable);
+
+		const std::string data = SymTableView::Build(symTable);
+		REQUIRE(data.size() % 8 == 0);
+
+		SymTableView view;
+		REQUIRE(view.Init(data));
+		REQUIRE(view.GetSourceFilename() == "test.h");
+
+		auto&& enums = view.GetEnums();
+		REQUIRE(enums.size() == 1);
+		REQUIRE(view.GetString(enums[0].mType.mId) == "NestedEnum");
+		REQUIRE(view.GetString(enums[0].mUnderlyingType) == "uint8_t");
+		REQUIRE(enums[0].mType.HasFlag(SymTableView::STRONGLY_TYPED));
+		REQUIRE(enums[0].mType.HasFlag(SymTableView::HAS_PARENT));
+
+		auto&& enumerators = view.GetEnumerators(enums[0]);
+		REQUIRE((enumerators.size() == 2 && view.GetString(enumerators[0]) == "FIRST" && view.GetString(enumerators[1]) == "SECOND"));
+
+		auto&& classes = view.GetClasses();
+		REQUIRE(classes.size() == 3);
+
+		SymTable typesOwner;
+		TClassType* pClassType = view.CreateClassType(classes[0], typesOwner);
+
+		REQUIRE(pClassType->mId == "TestClass");
+		REQUIRE(pClassType->mMangledId == symTable.LookUpNamedScope("TestClass")->mMangledId);
+		REQUIRE(pClassType->mIsStruct);
+		REQUIRE(pClassType->mAttributes.mSectionId == "common");
+		REQUIRE(pClassType->mpOwner == &typesOwner);
+		REQUIRE((pClassType->mBaseClasses.size() == 1 && pClassType->mBaseClasses[0].mFullName == "Base" && pClassType->mBaseClasses[0].mIsVirtualInherited));
+		REQUIRE((pClassType->mFields.size() == 1 && pClassType->mFields[0].mName == "mValue" && pClassType->mFields[0].mIsSerializable));
+	}
+
+	SECTION("TestExtract_PassView_ExtractsSameTypesAsFromTable")
+	{
+		SymTable symTable;
+		CreateTestTypes(symTable);
+
+		const std::string data = SymTableView::Build(symTable);
+
+		SymTableView view;
+		REQUIRE(view.Init(data));
+
+		SymTable typesOwner;
+
+		EnumsMetaExtractor tableEnumsExtractor(E_EMIT_FLAGS::ALL);
+		tableEnumsExtractor.Extract(symTable);
+
+		EnumsMetaExtractor viewEnumsExtractor(E_EMIT_FLAGS::ALL);
+		viewEnumsExtractor.Extract(view, typesOwner);
+
+		ClassMetaExtractor tableClassesExtractor(E_EMIT_FLAGS::ALL);
+		tableClassesExtractor.Extract(symTable);
+
+		ClassMetaExtractor viewClassesExtractor(E_EMIT_FLAGS::ALL);
+		viewClassesExtractor.Extract(view, typesOwner);
+
+		auto&& tableEnums = tableEnumsExtractor.GetTypesInfo();
+		auto&& viewEnums = viewEnumsExtractor.GetTypesInfo();
+
+		REQUIRE(tableEnums.size() == viewEnums.size());
+
+		for (size_t i = 0; i < tableEnums.size(); ++i)
+		{
+			REQUIRE(tableEnums[i]->mMangledId == viewEnums[i]->mMangledId);
+			REQUIRE(tableEnums[i]->mEnumerators == viewEnums[i]->mEnumerators);
+		}
+
+		auto&& tableClasses = tableClassesExtractor.GetTypesInfo();
+		auto&& viewClasses = viewClassesExtractor.GetTypesInfo();
+
+		REQUIRE(tableClasses.size() == 1); // \note Both the protected class and its nested one are skipped
+		REQUIRE(viewClasses.size() == 1);
+		REQUIRE(tableClasses[0]->mMangledId == viewClasses[0]->mMangledId);
+	}
+
+	SECTION("TestInit_PassInvalidData_ReturnsFalse")
+	{
+		SymTable symTable;
+		CreateTestTypes(symTable);
+
+		const std::string data = SymTableView::Build(symTable);
+
+		SymTableView view;
+		REQUIRE(!view.Init(std::string_view()));
+		REQUIRE(!view.Init(std::string_view(data).substr(0, data.size() - 8)));
+		REQUIRE(!view.Init(std::string(data.size(), '\0')));
+		REQUIRE(!view.IsValid());
+		REQUIRE(view.GetEnums().size() == 0);
+
+		std::string corruptedData = data;
+		corruptedData[sizeof(uint32_t) * 3 + 3] = '\x7F'; // \note Point the source filename's string out of the strings table
+
+		REQUIRE(view.Init(corruptedData));
+		REQUIRE(view.GetSourceFilename().empty());
+	}
+
+	SECTION("TestInit_PassBlobFromCachePack_ViewIsCreatedInPlace")
+	{
+		const std::string packFilename = "symtable_view_test.pack";
+
+		SymTable symTable;
+		CreateTestTypes(symTable);
+
+		{
+			CachePack pack;
+			pack.Add(ComputeHash128("first"), "odd"); // \note The blob's size breaks alignment of following ones if they aren't padded
+			pack.Add(ComputeHash128("second"), SymTableView::Build(symTable));
+
+			REQUIRE(pack.Save(packFilename));
+		}
+
+		{
+			CachePack pack;
+			REQUIRE(pack.Open(packFilename));
+
+			SymTableView view;
+			REQUIRE(view.Init(pack.Find(ComputeHash128("second"))));
+			REQUIRE(view.GetClasses().size() == 3);
+		}
+
+		std::remove(packFilename.c_str());
+	}
+}